@@ -0,0 +1,843 @@
+#ifndef BROKER_API_H
+#define BROKER_API_H
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <atomic>
+#include <thread>
+
+#include "drive_api.h"
+
+ /**
+ * @brief AMBER API
+ *
+ */
+namespace Amber{
+
+/**
+ * @brief 代理与客户端共享的内存区域，每个轴组一个
+ * @details 反馈以seqlock发布：写入前后各递增一次sequence，读取方在sequence为偶数且前后一致时得到完整的一帧；
+ * 指令队列为单生产者(控制端)单消费者(代理)环形队列，代理执行完一条指令后写入结果并递增head；
+ * 每条指令带控制端标识，标识与当前controller不一致的指令不执行，结果为-1
+ */
+class BrokerRegion
+{
+public:
+	static const uint32_t kMagic = 0x41494f53;
+	static const int kMaxAxis = 128;
+	static const uint32_t kQueueSize = 64;
+
+	enum CommandType
+	{
+		kEnable = 1,
+		kDisable = 2,
+		kSetControlMode = 3,
+		kSetPosition = 4,
+		kSetVelocity = 5,
+		kSetCurrent = 6,
+		kClearError = 7,
+	};
+
+	class Command
+	{
+	public:
+		uint64_t token;/**< 写入该指令的控制端标识，代理只执行与controller一致的指令 */
+		int32_t type;
+		int32_t mode;
+		double value[kMaxAxis];
+	};
+
+	uint32_t magic;
+	int32_t axis_num;
+	int32_t broker;
+	std::atomic <int32_t> running;
+	std::atomic <uint64_t> controller;
+
+	/* seqlock保护的反馈 */
+	std::atomic <uint32_t> sequence;
+	double stamp;
+	int32_t cvp_status;
+	int32_t enable_status;
+	int32_t enable;
+	double pos[kMaxAxis];
+	double vel[kMaxAxis];
+	double current[kMaxAxis];
+	char error[kMaxAxis][128];
+
+	/* 启动后不再变化的执行器信息 */
+	char ip[kMaxAxis][16];
+	char serial_number[kMaxAxis][32];
+	char mac_address[kMaxAxis][32];
+	char fw_version[kMaxAxis][32];
+	char hw_version[kMaxAxis][32];
+
+	std::atomic <uint32_t> head;
+	std::atomic <uint32_t> tail;
+	int32_t result[kQueueSize];
+	Command queue[kQueueSize];
+
+	static std::string Path(const std::string name,const std::string group_name)
+	{
+		return "/" + name + "." + group_name;
+	}
+
+	/**
+	 * @brief 映射共享内存
+	 * @param[in] path 共享内存路径
+	 * @param[in] create true时创建(已存在则失败)，false时打开已有区域
+	 * @param[in] mode 创建时的访问权限，不受umask影响
+	 * @return 映射地址
+	 *	 @retval NULL 失败
+	 */
+	static BrokerRegion *Map(const std::string path,const bool create,const mode_t mode=0600)
+	{
+		int fd = create ? shm_open(path.c_str(),O_CREAT | O_EXCL | O_RDWR,mode) : shm_open(path.c_str(),O_RDWR,0);
+		if (fd < 0)
+		{
+			return NULL;
+		}
+		if (create && (fchmod(fd,mode) < 0 || ftruncate(fd,sizeof(BrokerRegion)) < 0))
+		{
+			close(fd);
+			shm_unlink(path.c_str());
+			return NULL;
+		}
+
+		struct stat st;
+		void *p = MAP_FAILED;
+		if (fstat(fd,&st) == 0 && st.st_size >= (off_t)sizeof(BrokerRegion))
+		{
+			p = mmap(NULL,sizeof(BrokerRegion),PROT_READ | PROT_WRITE,MAP_SHARED,fd,0);
+		}
+		close(fd);
+
+		if (p == MAP_FAILED)
+		{
+			if (create)
+			{
+				shm_unlink(path.c_str());
+			}
+			return NULL;
+		}
+		return (BrokerRegion *)p;
+	}
+
+	static void Unmap(BrokerRegion *region)
+	{
+		munmap(region,sizeof(BrokerRegion));
+	}
+
+	static void Copy(char *dst,const std::string &src,const size_t size)
+	{
+		strncpy(dst,src.c_str(),size - 1);
+		dst[size - 1] = '\0';
+	}
+};
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2,"shared memory atomics must be lock free");
+
+/**
+ * @brief 轴组代理
+ * @details 在本进程中持有轴组，以固定周期读取反馈并发布到共享内存，同时执行控制端经共享内存指令队列下发的指令，
+ * 使本机的其他进程无需访问网络即可读取反馈，并由唯一的控制端下发指令。
+ * 每个周期对每个轴组先执行队列中的全部指令，再调用一次GetCvp；使能状态与错误信息每100个周期刷新一次
+ */
+class Broker final
+{
+private:
+	std::string name_;
+	vector <string> group_name_list_;
+	vector <std::shared_ptr <AiosGroup> > group_list_;
+	vector <BrokerRegion *> region_list_;
+
+	std::thread thread_;
+	std::atomic <bool> running_;
+	unsigned int period_;
+
+	static int Execute(AiosGroup &group,const BrokerRegion::Command &command,const int axis_num)
+	{
+		Eigen::VectorXd value = Eigen::Map<const Eigen::VectorXd>(command.value,axis_num);
+
+		switch (command.type)
+		{
+		case BrokerRegion::kEnable:
+			return group.Enable();
+		case BrokerRegion::kDisable:
+			return group.Disable();
+		case BrokerRegion::kSetControlMode:
+			return group.SetControlMode((ControlMode)command.mode);
+		case BrokerRegion::kSetPosition:
+			return group.SetPosition(value);
+		case BrokerRegion::kSetVelocity:
+			return group.SetVelocity(value);
+		case BrokerRegion::kSetCurrent:
+			return group.SetCurrent(value);
+		case BrokerRegion::kClearError:
+			group.ClearError();
+			return 0;
+		default:
+			return -1;
+		}
+	}
+
+	static void Publish(AiosGroup &group,BrokerRegion *region,const bool refresh)
+	{
+		CvpData fb;
+		double stamp;
+		int cvp_status = group.GetCvp(fb,stamp);
+		if (cvp_status != 0)
+		{
+			stamp = GetMonotonicTime();
+		}
+
+		bool enable = false;
+		int enable_status = 0;
+		vector <string> error;
+		if (refresh)
+		{
+			enable_status = group.IsEnable(enable);
+			error = group.GetErrorDetails();
+		}
+
+		uint32_t sequence = region->sequence.load(std::memory_order_relaxed);
+		region->sequence.store(sequence + 1,std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		region->stamp = stamp;
+		region->cvp_status = cvp_status;
+		if (cvp_status == 0 && fb.pos.size() == region->axis_num)
+		{
+			for (int i=0; i<region->axis_num; i++)
+			{
+				region->pos[i] = fb.pos(i);
+				region->vel[i] = fb.vel(i);
+				region->current[i] = fb.current(i);
+			}
+		}
+		if (refresh)
+		{
+			region->enable_status = enable_status;
+			region->enable = enable;
+			for (int i=0; i<region->axis_num; i++)
+			{
+				BrokerRegion::Copy(region->error[i],i < (int)error.size() ? error[i] : "",sizeof(region->error[i]));
+			}
+		}
+
+		region->sequence.store(sequence + 2,std::memory_order_release);
+	}
+
+	void Run()
+	{
+		struct timespec deadline;
+		clock_gettime(CLOCK_MONOTONIC,&deadline);
+
+		for (unsigned long cycle = 0; running_; cycle++)
+		{
+			for (size_t g=0; g<group_list_.size(); g++)
+			{
+				BrokerRegion *region = region_list_[g];
+				uint32_t head = region->head.load(std::memory_order_relaxed);
+				uint32_t tail = region->tail.load(std::memory_order_acquire);
+
+				for ( ; head != tail; head++)
+				{
+					const uint32_t slot = head % BrokerRegion::kQueueSize;
+					const uint64_t token = region->queue[slot].token;
+					if (token == 0 || token != region->controller.load())
+					{
+						region->result[slot] = -1;
+					}
+					else
+					{
+						region->result[slot] = Execute(*group_list_[g],region->queue[slot],region->axis_num);
+					}
+					region->head.store(head + 1,std::memory_order_release);
+				}
+
+				Publish(*group_list_[g],region,cycle % 100 == 0);
+			}
+
+			deadline.tv_nsec += (long)period_ * 1000;
+			while (deadline.tv_nsec >= 1000000000L)
+			{
+				deadline.tv_nsec -= 1000000000L;
+				deadline.tv_sec++;
+			}
+			clock_nanosleep(CLOCK_MONOTONIC,TIMER_ABSTIME,&deadline,NULL);
+		}
+	}
+
+public:
+	Broker():running_(false),period_(1000)
+	{
+	}
+
+	~Broker()
+	{
+		Stop();
+	}
+
+	/**
+	 * @brief 添加由本进程管理的轴组
+	 * @attention 须在Start之前调用
+	 *
+	 * @param[in] group_name 轴组名称，客户端按此名称连接
+	 * @param[in] group 轴组对象，来源于Lookup
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败，名称为空或重复、轴数超过BrokerRegion::kMaxAxis或已启动
+	 */
+	int AddGroup(const std::string group_name,std::shared_ptr <AiosGroup> group)
+	{
+		if (running_ || !group || group_name.empty() || group->Size() > BrokerRegion::kMaxAxis ||
+			std::find(group_name_list_.begin(),group_name_list_.end(),group_name) != group_name_list_.end())
+		{
+			return -1;
+		}
+
+		group_name_list_.push_back(group_name);
+		group_list_.push_back(group);
+		return 0;
+	}
+
+	/**
+	 * @brief 启动代理
+	 * @details 为每个轴组创建共享内存区域/dev/shm/<name>.<group_name>，以period为周期读取反馈并以seqlock方式发布；
+	 * 同时从共享内存指令队列中取出控制端的指令下发到轴组。
+	 * 区域默认只允许代理进程的用户访问；其他用户的进程需要连接时传入0660，并使这些进程属于代理进程的有效组
+	 *
+	 * @param[in] name 共享内存名称前缀，默认为"aios"
+	 * @param[in] period 反馈发布周期(单位:us)
+	 * @param[in] mode 共享内存的访问权限，默认为0600
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败，未添加轴组、已启动、同名的代理正在运行或mode允许其他用户访问
+	 */
+	int Start(const std::string name="aios",const unsigned int period=1000,const mode_t mode=0600)
+	{
+		if (running_ || group_list_.empty() || period == 0 || (mode & 0007) != 0)
+		{
+			return -1;
+		}
+
+		name_ = name;
+		period_ = period;
+
+		for (size_t g=0; g<group_list_.size(); g++)
+		{
+			const std::string path = BrokerRegion::Path(name_,group_name_list_[g]);
+			BrokerRegion *region = BrokerRegion::Map(path,true,mode);
+
+			/* 异常退出的代理遗留的区域可以删除后重建 */
+			if (!region && errno == EEXIST)
+			{
+				BrokerRegion *stale = BrokerRegion::Map(path,false);
+				if (stale && stale->magic == BrokerRegion::kMagic && kill(stale->broker,0) == -1 && errno == ESRCH)
+				{
+					shm_unlink(path.c_str());
+					region = BrokerRegion::Map(path,true,mode);
+				}
+				if (stale)
+				{
+					BrokerRegion::Unmap(stale);
+				}
+			}
+			if (!region)
+			{
+				Stop();
+				return -1;
+			}
+			region_list_.push_back(region);
+
+			AiosGroup &group = *group_list_[g];
+			vector <AiosAttribute> info = group.GetActuatorInfo();
+
+			region->axis_num = group.Size();
+			region->broker = getpid();
+			region->controller = 0;
+			region->sequence = 0;
+			region->head = 0;
+			region->tail = 0;
+			region->cvp_status = -1;
+			region->enable_status = -1;
+			for (int i=0; i<region->axis_num && i<(int)info.size(); i++)
+			{
+				BrokerRegion::Copy(region->ip[i],info[i].ip_,sizeof(region->ip[i]));
+				BrokerRegion::Copy(region->serial_number[i],info[i].serial_number_,sizeof(region->serial_number[i]));
+				BrokerRegion::Copy(region->mac_address[i],info[i].mac_address_,sizeof(region->mac_address[i]));
+				BrokerRegion::Copy(region->fw_version[i],info[i].fw_version_,sizeof(region->fw_version[i]));
+				BrokerRegion::Copy(region->hw_version[i],info[i].hw_version_,sizeof(region->hw_version[i]));
+			}
+			Publish(group,region,true);
+			region->running = 1;
+			region->magic = BrokerRegion::kMagic;
+		}
+
+		running_ = true;
+		thread_ = std::thread(&Broker::Run,this);
+		return 0;
+	}
+
+	/**
+	 * @brief 停止代理并删除共享内存，已连接的客户端随后读取失败
+	 *
+	 */
+	void Stop()
+	{
+		running_ = false;
+
+		if (thread_.joinable())
+		{
+			thread_.join();
+		}
+
+		for (size_t g=0; g<region_list_.size(); g++)
+		{
+			region_list_[g]->running = 0;
+			BrokerRegion::Unmap(region_list_[g]);
+			shm_unlink(BrokerRegion::Path(name_,group_name_list_[g]).c_str());
+		}
+		region_list_.clear();
+	}
+};
+
+/**
+ * @brief 代理轴组的客户端，接口与AiosGroup一致
+ * @details 读取函数从共享内存取得代理最近一次发布的数据，不经过网络；
+ * 下发指令的函数只有控制端可用，SetPosition、SetVelocity、SetCurrent进入队列即返回，
+ * 其余指令等待代理执行完毕并返回其结果
+ */
+class BrokerClient final
+{
+private:
+	std::string group_name_;
+	uint64_t token_;
+	BrokerRegion *region_;
+
+	/* 读取一帧一致的反馈，代理在发布过程中退出时sequence停在奇数，最多重试100ms */
+	template <typename F>
+	int Read(F read)
+	{
+		if (!region_ || !region_->running)
+		{
+			return -1;
+		}
+
+		double deadline = 0.0;
+		for (unsigned long attempt=1; ; attempt++)
+		{
+			if (attempt % 1000 == 0)
+			{
+				const double now = GetMonotonicTime();
+				deadline = deadline == 0.0 ? now + 0.1 : deadline;
+				if (!region_->running || (kill(region_->broker,0) == -1 && errno == ESRCH) || now > deadline)
+				{
+					return -1;
+				}
+				std::this_thread::yield();
+			}
+
+			uint32_t begin = region_->sequence.load(std::memory_order_acquire);
+			if (begin & 1)
+			{
+				continue;
+			}
+			int ret = read();
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (region_->sequence.load(std::memory_order_relaxed) == begin)
+			{
+				return ret;
+			}
+		}
+	}
+
+	int Push(const BrokerRegion::CommandType type,const Eigen::VectorXd *value,const int mode,const bool wait)
+	{
+		if (!region_ || !token_ || !region_->running || (value && value->size() != region_->axis_num))
+		{
+			return -1;
+		}
+
+		uint32_t tail = region_->tail.load(std::memory_order_relaxed);
+		if (tail - region_->head.load(std::memory_order_acquire) >= BrokerRegion::kQueueSize)
+		{
+			return -1;
+		}
+
+		BrokerRegion::Command &command = region_->queue[tail % BrokerRegion::kQueueSize];
+		command.token = token_;
+		command.type = type;
+		command.mode = mode;
+		for (int i=0; value && i<region_->axis_num; i++)
+		{
+			command.value[i] = (*value)(i);
+		}
+		region_->tail.store(tail + 1,std::memory_order_release);
+
+		if (!wait)
+		{
+			return 0;
+		}
+
+		/* 最多等待5s，代理停止时失败 */
+		const double deadline = GetMonotonicTime() + 5.0;
+		while ((int32_t)(region_->head.load(std::memory_order_acquire) - (tail + 1)) < 0)
+		{
+			if (!region_->running || GetMonotonicTime() > deadline)
+			{
+				return -1;
+			}
+			usleep(100);
+		}
+		return region_->result[tail % BrokerRegion::kQueueSize];
+	}
+
+public:
+	BrokerClient():token_(0),region_(NULL)
+	{
+	}
+
+	~BrokerClient()
+	{
+		Disconnect();
+	}
+
+	/**
+	 * @brief 连接代理进程中的轴组
+	 * @details 只读客户端的数量不限；同一时刻只有一个控制端，控制端断开或进程退出后其他进程才能取得控制权
+	 *
+	 * @param[in] group_name 轴组名称，对应Broker::AddGroup
+	 * @param[in] name 共享内存名称前缀，对应Broker::Start
+	 * @param[in] controller 是否申请控制权，只有控制端可以调用下发指令的函数
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败，代理未运行、轴组不存在或控制权已被占用
+	 */
+	int Connect(const std::string group_name,const std::string name="aios",const bool controller=false)
+	{
+		Disconnect();
+
+		region_ = BrokerRegion::Map(BrokerRegion::Path(name,group_name),false);
+		if (!region_)
+		{
+			return -1;
+		}
+		if (region_->magic != BrokerRegion::kMagic || !region_->running)
+		{
+			Disconnect();
+			return -1;
+		}
+
+		if (controller)
+		{
+			/* 控制权标识的高32位为进程号，低32位区分同一进程内的客户端 */
+			static std::atomic <uint32_t> count(0);
+			const uint64_t self = ((uint64_t)getpid() << 32) | ++count;
+			uint64_t owner = region_->controller.load();
+
+			/* 占用控制权的进程已退出时可以接管 */
+			if (owner != 0 && kill((pid_t)(owner >> 32),0) == -1 && errno == ESRCH)
+			{
+				region_->controller.compare_exchange_strong(owner,0);
+			}
+			owner = 0;
+			if (!region_->controller.compare_exchange_strong(owner,self))
+			{
+				Disconnect();
+				return -1;
+			}
+			token_ = self;
+		}
+
+		group_name_ = group_name;
+		return 0;
+	}
+
+	/**
+	 * @brief 断开连接并释放控制权
+	 *
+	 */
+	void Disconnect()
+	{
+		if (region_)
+		{
+			if (token_)
+			{
+				region_->controller.compare_exchange_strong(token_,0);
+			}
+			BrokerRegion::Unmap(region_);
+		}
+		region_ = NULL;
+		token_ = 0;
+	}
+
+	/**
+	 * @brief 获得轴组内执行器的个数
+	 *
+	 * @return 轴组内执行器的个数，未连接时为0
+	 */
+	int Size()const
+	{
+		return region_ ? region_->axis_num : 0;
+	}
+
+	/**
+	 * @brief 获取轴组内执行器的具体信息
+	 *
+	 * @return 轴组内执行器的具体信息
+	 */
+	vector <AiosAttribute> GetActuatorInfo()
+	{
+		vector <AiosAttribute> info;
+
+		for (int i=0; i<Size(); i++)
+		{
+			AiosAttribute attribute;
+			attribute.ip_ = region_->ip[i];
+			attribute.serial_number_ = region_->serial_number[i];
+			attribute.mac_address_ = region_->mac_address[i];
+			attribute.fw_version_ = region_->fw_version[i];
+			attribute.hw_version_ = region_->hw_version[i];
+			attribute.m_ = 0;
+			attribute.id_ = 0;
+			attribute.drive_status_ = true;
+			info.push_back(attribute);
+		}
+		return info;
+	}
+
+	/**
+	 * @brief 获取代理最近一次发布的位置、速度和电流
+	 * @details 从共享内存读取，不经过网络
+	 *
+	 * @param[out] fb 当前位置、速度和电流
+	 * @param[out] stamp 代理收到该帧的时间戳(单位:s，CLOCK_MONOTONIC时基)
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败，代理已停止或最近一次读取反馈失败
+	 */
+	int GetCvp(CvpData &fb,double &stamp)
+	{
+		const int n = Size();
+		fb.pos.resize(n);
+		fb.vel.resize(n);
+		fb.current.resize(n);
+
+		return Read([&]()
+		{
+			stamp = region_->stamp;
+			for (int i=0; i<n; i++)
+			{
+				fb.pos(i) = region_->pos[i];
+				fb.vel(i) = region_->vel[i];
+				fb.current(i) = region_->current[i];
+			}
+			return region_->cvp_status;
+		});
+	}
+
+	/**
+	 * @brief 获取代理最近一次发布的位置、速度和电流
+	 *
+	 * @param[out] fb 当前位置、速度和电流
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败
+	 */
+	int GetCvp(CvpData &fb)
+	{
+		double stamp;
+		return GetCvp(fb,stamp);
+	}
+
+	/**
+	 * @brief 获取当前位置
+	 *
+	 * @param[out] pos 当前位置(单位:count)
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败
+	 */
+	int GetPosition(Eigen::VectorXd &pos)
+	{
+		CvpData fb;
+		if (GetCvp(fb) == -1)
+		{
+			return -1;
+		}
+		pos = fb.pos;
+		return 0;
+	}
+
+	/**
+	 * @brief 获取当前速度
+	 *
+	 * @param[out] vel 当前速度(单位:count/s)
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败
+	 */
+	int GetVelocity(Eigen::VectorXd &vel)
+	{
+		CvpData fb;
+		if (GetCvp(fb) == -1)
+		{
+			return -1;
+		}
+		vel = fb.vel;
+		return 0;
+	}
+
+	/**
+	 * @brief 获取当前电流
+	 *
+	 * @param[out] current 当前电流(单位:A)
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败
+	 */
+	int GetCurrent(Eigen::VectorXd &current)
+	{
+		CvpData fb;
+		if (GetCvp(fb) == -1)
+		{
+			return -1;
+		}
+		current = fb.current;
+		return 0;
+	}
+
+	/**
+	 * @brief 获取aios轴组是否伺服使能的信息，每100个发布周期刷新一次
+	 *
+	 * @param[out] status 轴组的伺服使能状态，true:当前处于使能状态 false：当前处于失能状态或轴组内aios部分使能
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败
+	 */
+	int IsEnable( bool &status )
+	{
+		return Read([&]()
+		{
+			status = region_->enable != 0;
+			return region_->enable_status;
+		});
+	}
+
+	/**
+	 * @brief 获取报错信息，每100个发布周期刷新一次
+	 * @return 轴组内各执行器错误信息
+	 */
+	vector <string> GetErrorDetails()
+	{
+		vector <string> error(Size());
+		Read([&]()
+		{
+			for (size_t i=0; i<error.size(); i++)
+			{
+				error[i] = region_->error[i];
+			}
+			return 0;
+		});
+		return error;
+	}
+
+	/**
+	 * @brief 使能aios轴组，仅控制端可用
+	 *
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败
+	 */
+	int Enable()
+	{
+		return Push(BrokerRegion::kEnable,NULL,0,true);
+	}
+
+	/**
+	 * @brief 失能aios轴组，仅控制端可用
+	 *
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败
+	 */
+	int Disable()
+	{
+		return Push(BrokerRegion::kDisable,NULL,0,true);
+	}
+
+	/**
+	 * @brief 设置运动控制模式，仅控制端可用
+	 *
+	 * @param[in] mode 运动控制模式
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败
+	 */
+	int SetControlMode(const ControlMode mode)
+	{
+		return Push(BrokerRegion::kSetControlMode,NULL,mode,true);
+	}
+
+	/**
+	 * @brief 使轴组运动到目标位置，仅控制端可用，进入队列即返回
+	 *
+	 * @param[in] pos 目标位置(单位:count)
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败，非控制端、维数不符或队列已满
+	 */
+	int SetPosition(const Eigen::VectorXd pos)
+	{
+		return Push(BrokerRegion::kSetPosition,&pos,0,false);
+	}
+
+	/**
+	 * @brief 使执行器达到目标速度，仅控制端可用，进入队列即返回
+	 *
+	 * @param[in] vel 目标速度(单位:count/s)
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败，非控制端、维数不符或队列已满
+	 */
+	int SetVelocity(const Eigen::VectorXd vel)
+	{
+		return Push(BrokerRegion::kSetVelocity,&vel,0,false);
+	}
+
+	/**
+	 * @brief 使执行器达到目标电流，仅控制端可用，进入队列即返回
+	 *
+	 * @param[in] current 目标电流(单位:A)
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败，非控制端、维数不符或队列已满
+	 */
+	int SetCurrent(const Eigen::VectorXd current)
+	{
+		return Push(BrokerRegion::kSetCurrent,&current,0,false);
+	}
+
+	/**
+	 * @brief 清除轴组内的报错信息，仅控制端可用
+	 * @attention 确定解除错误源头后清除才有效
+	 *
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败
+	 */
+	int ClearError()
+	{
+		return Push(BrokerRegion::kClearError,NULL,0,true);
+	}
+};
+
+}
+
+#endif
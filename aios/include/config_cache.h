@@ -0,0 +1,350 @@
+#ifndef CONFIG_CACHE_H
+#define CONFIG_CACHE_H
+
+#include "drive_api.h"
+
+namespace Amber{
+
+/**
+ * @brief 轴组配置的本端缓存
+ * @details 包装一个AiosGroup，GetControlMode、GetPostionKp、GetVelocityLimit、GetCurrentLimit和GetPositionProfileParameters
+ * 首次读取时访问执行器并缓存结果，之后直接返回缓存值而不经过网络；经本对象调用的设置函数成功后同步更新缓存，
+ * ClearConfig、Reboot及任何失败的访问使对应缓存失效。
+ * 缓存只对经本对象的修改可见，直接通过AiosGroup修改上述配置后应调用Invalidate；与AiosGroup一样不是线程安全的。
+ * 缓存只作用于经本对象的读取：Motion::MoveTo等库内函数仍直接通过网络读取限幅与加减速参数，不使用本缓存
+ */
+class ConfigCache
+{
+private:
+	AiosGroup *group_;
+
+	bool control_mode_valid_;
+	bool position_kp_valid_;
+	bool velocity_limit_valid_;
+	bool current_limit_valid_;
+	bool profile_valid_;
+
+	ControlMode control_mode_;
+	Eigen::VectorXd position_kp_;
+	Eigen::VectorXd velocity_limit_;
+	Eigen::VectorXd current_limit_;
+	ProfileParameters profile_;
+
+public:
+
+	/**
+	 * @brief 构造配置缓存，初始时缓存为空
+	 *
+	 * @param[in] group 轴组对象，须在本对象的生命周期内有效
+	 */
+	ConfigCache(AiosGroup *group)
+		: group_(group)
+	{
+		Invalidate();
+	}
+
+	/**
+	 * @brief 获取包装的轴组对象
+	 *
+	 * @return 轴组对象
+	 */
+	AiosGroup *GetGroup()
+	{
+		return group_;
+	}
+
+	/**
+	 * @brief 使全部缓存失效，下次读取时重新访问执行器
+	 *
+	 */
+	void Invalidate()
+	{
+		control_mode_valid_ = false;
+		position_kp_valid_ = false;
+		velocity_limit_valid_ = false;
+		current_limit_valid_ = false;
+		profile_valid_ = false;
+	}
+
+	/**
+	 * @brief 从执行器重新读取全部缓存的配置
+	 *
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败，读取失败的配置缓存失效
+	 */
+	int Refresh()
+	{
+		Invalidate();
+
+		int ret = 0;
+		Eigen::VectorXd value;
+		ProfileParameters para;
+		ControlMode mode;
+		if (GetControlMode(mode) == -1)
+			ret = -1;
+		if (GetPostionKp(value) == -1)
+			ret = -1;
+		if (GetVelocityLimit(value) == -1)
+			ret = -1;
+		if (GetCurrentLimit(value) == -1)
+			ret = -1;
+		if (GetPositionProfileParameters(para) == -1)
+			ret = -1;
+		return ret;
+	}
+
+	/**
+	 * @brief 获取运动控制模式
+	 * @details 库中没有返回控制模式的读取接口(AiosGroup::GetControlMode只返回执行成功与否)，
+	 * 这里从各执行器的控制器配置中读取control_mode，轴组为空、应答不是对象或轴组内不一致时失败
+	 *
+	 * @param[out] mode 运动控制模式
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败
+	 */
+	int GetControlMode(ControlMode &mode)
+	{
+		if (!control_mode_valid_)
+		{
+			const int n = group_->Size();
+			if (n <= 0)
+				return -1;
+			vector <int> index(n);
+			vector <Json::Value> send_data(n),recv_data(n);
+			for (int i = 0; i < n; i++)
+			{
+				index[i] = i;
+				send_data[i]["method"] = "GET";
+				send_data[i]["reqTarget"] = string(group_->m_list_.at(i) == 0 ? "/m0" : "/m1") + "/controller/config";
+			}
+			group_->SendTo(index,send_data.data(),2334);
+			group_->RecvFrom(index,recv_data.data(),2334);
+			for (int i = 0; i < n; i++)
+			{
+				if (!recv_data[i].isObject() || !recv_data[i]["control_mode"].isIntegral() || recv_data[i]["control_mode"].asInt() != recv_data[0]["control_mode"].asInt())
+					return -1;
+			}
+			control_mode_ = (ControlMode)recv_data[0]["control_mode"].asInt();
+			control_mode_valid_ = true;
+		}
+		mode = control_mode_;
+		return 0;
+	}
+
+	/**
+	 * @brief 设置运动控制模式，同AiosGroup::SetControlMode
+	 *
+	 * @param[in] mode 运动控制模式
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败
+	 */
+	int SetControlMode(const ControlMode mode)
+	{
+		control_mode_valid_ = false;
+		if (group_->SetControlMode(mode) == -1)
+			return -1;
+		control_mode_ = mode;
+		control_mode_valid_ = true;
+		return 0;
+	}
+
+	/**
+	 * @brief 获取位置环比例量，同AiosGroup::GetPostionKp
+	 *
+	 * @param[out] kp 位置环比例量
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败
+	 */
+	int GetPostionKp(Eigen::VectorXd &kp)
+	{
+		if (!position_kp_valid_)
+		{
+			if (group_->GetPostionKp(position_kp_) == -1)
+				return -1;
+			position_kp_valid_ = true;
+		}
+		kp = position_kp_;
+		return 0;
+	}
+
+	/**
+	 * @brief 设置位置环比例量，同AiosGroup::SetPostionKp
+	 *
+	 * @param[in] kp 位置环比例量
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败
+	 */
+	int SetPostionKp(const Eigen::VectorXd kp)
+	{
+		position_kp_valid_ = false;
+		if (group_->SetPostionKp(kp) == -1)
+			return -1;
+		position_kp_ = kp;
+		position_kp_valid_ = true;
+		return 0;
+	}
+
+	/**
+	 * @brief 获取最大速度，同AiosGroup::GetVelocityLimit
+	 *
+	 * @param[out] limit 最大速度
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败
+	 */
+	int GetVelocityLimit(Eigen::VectorXd &limit)
+	{
+		if (!velocity_limit_valid_)
+		{
+			if (group_->GetVelocityLimit(velocity_limit_) == -1)
+				return -1;
+			velocity_limit_valid_ = true;
+		}
+		limit = velocity_limit_;
+		return 0;
+	}
+
+	/**
+	 * @brief 设置最大速度，同AiosGroup::SetVelocityLimit
+	 *
+	 * @param[in] limit 最大速度
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败
+	 */
+	int SetVelocityLimit(const Eigen::VectorXd limit)
+	{
+		velocity_limit_valid_ = false;
+		if (group_->SetVelocityLimit(limit) == -1)
+			return -1;
+		velocity_limit_ = limit;
+		velocity_limit_valid_ = true;
+		return 0;
+	}
+
+	/**
+	 * @brief 获取最大电流，同AiosGroup::GetCurrentLimit
+	 *
+	 * @param[out] limit 最大电流
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败
+	 */
+	int GetCurrentLimit(Eigen::VectorXd &limit)
+	{
+		if (!current_limit_valid_)
+		{
+			if (group_->GetCurrentLimit(current_limit_) == -1)
+				return -1;
+			current_limit_valid_ = true;
+		}
+		limit = current_limit_;
+		return 0;
+	}
+
+	/**
+	 * @brief 设置最大电流，同AiosGroup::SetCurrentLimit
+	 *
+	 * @param[in] limit 最大电流
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败
+	 */
+	int SetCurrentLimit(const Eigen::VectorXd limit)
+	{
+		current_limit_valid_ = false;
+		if (group_->SetCurrentLimit(limit) == -1)
+			return -1;
+		current_limit_ = limit;
+		current_limit_valid_ = true;
+		return 0;
+	}
+
+	/**
+	 * @brief 获取梯形加减速参数，同AiosGroup::GetPositionProfileParameters
+	 *
+	 * @param[out] para 加减速参数
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败
+	 */
+	int GetPositionProfileParameters(ProfileParameters &para)
+	{
+		if (!profile_valid_)
+		{
+			if (group_->GetPositionProfileParameters(profile_) == -1)
+				return -1;
+			profile_valid_ = true;
+		}
+		para = profile_;
+		return 0;
+	}
+
+	/**
+	 * @brief 设置梯形加减速参数，同AiosGroup::SetPositionProfileParameters
+	 *
+	 * @param[in] para 加减速参数
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败
+	 */
+	int SetPositionProfileParameters(const ProfileParameters para)
+	{
+		profile_valid_ = false;
+		if (group_->SetPositionProfileParameters(para) == -1)
+			return -1;
+		profile_ = para;
+		profile_valid_ = true;
+		return 0;
+	}
+
+	/**
+	 * @brief 保存配置，同AiosGroup::SaveConfig，缓存内容保持不变
+	 *
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败，全部缓存失效
+	 */
+	int SaveConfig()
+	{
+		if (group_->SaveConfig() == -1)
+		{
+			Invalidate();
+			return -1;
+		}
+		return 0;
+	}
+
+	/**
+	 * @brief 清除修改的配置，同AiosGroup::ClearConfig
+	 * @details 执行器恢复为已保存的配置，全部缓存失效
+	 *
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败
+	 */
+	int ClearConfig()
+	{
+		Invalidate();
+		return group_->ClearConfig();
+	}
+
+	/**
+	 * @brief 重启，同AiosGroup::Reboot，全部缓存失效
+	 *
+	 */
+	void Reboot()
+	{
+		Invalidate();
+		group_->Reboot();
+	}
+};
+
+}
+
+#endif
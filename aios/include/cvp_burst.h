@@ -0,0 +1,125 @@
+#ifndef CVP_BURST_H
+#define CVP_BURST_H
+
+#include <math.h>
+#include <algorithm>
+
+#include "drive_api.h"
+
+namespace Amber{
+
+class CvpBurst
+{
+public:
+	Eigen::MatrixXd pos;/**< 位置(单位:count)，轴数×样本数，失败的帧为NaN */
+	Eigen::MatrixXd vel;/**< 速度(单位:count/s)，轴数×样本数，失败的帧为NaN */
+	Eigen::MatrixXd current;/**< 电流(单位:A)，轴数×样本数，失败的帧为NaN */
+	Eigen::MatrixXd stamp;/**< 接收时间戳(单位:s，CLOCK_MONOTONIC时基)，轴数×样本数，同一帧内各轴相同，失败的帧为失败时刻 */
+	vector <bool> valid;/**< 各帧是否有效 */
+	unsigned int samples;/**< 采集的帧数，含失败的帧 */
+	unsigned int lost;/**< 失败的帧数 */
+	double rate;/**< 实际采样率(单位:Hz)，按全部帧计算 */
+	double max_gap;/**< 相邻有效帧的最大间隔(单位:s) */
+	unsigned int gap_count;/**< 相邻有效帧的间隔超过平均帧间隔两倍的次数 */
+};
+
+/**
+ * @brief 以最高速率连续采集轴组的位置、速度和电流
+ * @details 连续调用GetCvp(fb,stamp)，每帧应答到达后立即发送下一帧请求，样本直接写入burst的各矩阵(轴数×样本数，每列一帧)；
+ * 库按帧收发，同一时刻只有一帧请求在途。失败的帧不补值：位置、速度和电流填NaN，valid中对应元素为false，并计入lost，
+ * 用于系统辨识时应按valid剔除。矩阵尺寸不符时只在开始前分配一次，可重复使用同一个burst对象
+ *
+ * @param[in] group 轴组对象
+ * @param[in] samples 采集的帧数
+ * @param[out] burst 采集结果及统计信息
+ * @return 执行成功与否
+ *	 @retval 0 成功，至少一帧有效
+ *	 @retval -1 失败，参数不合法或全部帧均失败
+ */
+inline int CaptureCvpBurst(AiosGroup *group,const unsigned int samples,CvpBurst &burst)
+{
+	if (group == NULL || samples == 0)
+	{
+		return -1;
+	}
+
+	const int n = group->Size();
+	const long m = samples;
+	if (burst.pos.rows() != n || burst.pos.cols() != m)
+	{
+		burst.pos.resize(n,m);
+	}
+	if (burst.vel.rows() != n || burst.vel.cols() != m)
+	{
+		burst.vel.resize(n,m);
+	}
+	if (burst.current.rows() != n || burst.current.cols() != m)
+	{
+		burst.current.resize(n,m);
+	}
+	if (burst.stamp.rows() != n || burst.stamp.cols() != m)
+	{
+		burst.stamp.resize(n,m);
+	}
+	burst.valid.assign(samples,false);
+
+	CvpData fb;
+	fb.pos = Eigen::VectorXd::Zero(n);
+	fb.vel = Eigen::VectorXd::Zero(n);
+	fb.current = Eigen::VectorXd::Zero(n);
+	burst.lost = 0;
+
+	for (unsigned int k=0; k<samples; k++)
+	{
+		double stamp;
+		if (group->GetCvp(fb,stamp) != 0 || fb.pos.size() != n || fb.vel.size() != n || fb.current.size() != n)
+		{
+			burst.pos.col(k).setConstant(NAN);
+			burst.vel.col(k).setConstant(NAN);
+			burst.current.col(k).setConstant(NAN);
+			burst.stamp.col(k).setConstant(GetMonotonicTime());
+			burst.lost++;
+			continue;
+		}
+
+		burst.pos.col(k) = fb.pos;
+		burst.vel.col(k) = fb.vel;
+		burst.current.col(k) = fb.current;
+		burst.stamp.col(k).setConstant(stamp);
+		burst.valid[k] = true;
+	}
+
+	burst.samples = samples;
+	burst.rate = 0.0;
+	burst.max_gap = 0.0;
+	burst.gap_count = 0;
+	if (samples > 1 && n > 0)
+	{
+		const double mean = (burst.stamp(0,samples - 1) - burst.stamp(0,0)) / (samples - 1);
+		burst.rate = mean > 0.0 ? 1.0 / mean : 0.0;
+
+		int last = -1;
+		for (unsigned int k=0; k<samples; k++)
+		{
+			if (!burst.valid[k])
+			{
+				continue;
+			}
+			if (last >= 0)
+			{
+				const double gap = burst.stamp(0,k) - burst.stamp(0,last);
+				burst.max_gap = std::max(burst.max_gap,gap);
+				if (gap > 2.0 * mean)
+				{
+					burst.gap_count++;
+				}
+			}
+			last = k;
+		}
+	}
+	return burst.lost == samples ? -1 : 0;
+}
+
+}
+
+#endif
@@ -0,0 +1,190 @@
+#ifndef CVP_ESTIMATOR_H
+#define CVP_ESTIMATOR_H
+
+#include <mutex>
+
+#include "drive_api.h"
+
+namespace Amber{
+
+/**
+ * @brief 逐轴alpha-beta状态估计器
+ * @details 以带接收时间戳的反馈样本逐轴修正位置和速度：预测位置为上次估计位置加速度乘以间隔，
+ * 位置按alpha、速度按beta/间隔修正预测残差。查询时由最近一次修正后的状态按速度外推到指定时刻，
+ * 不访问网络，可在高于通信频率的控制线程中调用；超过stale_time未收到样本的轴标记为过期。
+ * Update与GetState线程安全
+ */
+class CvpEstimator
+{
+private:
+	int axis_num_;
+	double alpha_;
+	double beta_;
+	double stale_time_;
+	Eigen::VectorXd pos_;
+	Eigen::VectorXd vel_;
+	Eigen::VectorXd current_;
+	Eigen::VectorXd stamp_;
+	vector <bool> valid_;
+	std::mutex mutex_;
+
+	void UpdateAxis(const int i,const double pos,const double vel,const double current,const double stamp)
+	{
+		if (!valid_[i])
+		{
+			pos_(i) = pos;
+			vel_(i) = vel;
+			valid_[i] = true;
+		}
+		else
+		{
+			const double dt = stamp - stamp_(i);
+			if (dt <= 0.0)
+			{
+				return;
+			}
+
+			const double predict = pos_(i) + vel_(i) * dt;
+			const double residual = pos - predict;
+			pos_(i) = predict + alpha_ * residual;
+			vel_(i) = vel_(i) + beta_ * residual / dt;
+		}
+
+		current_(i) = current;
+		stamp_(i) = stamp;
+	}
+
+public:
+
+	/**
+	 * @brief 构造逐轴alpha-beta状态估计器
+	 *
+	 * @param[in] axis_num 轴数
+	 * @param[in] alpha 位置修正系数(0~1)
+	 * @param[in] beta 速度修正系数(0~1)
+	 * @param[in] stale_time 超过该时长(单位:s)未收到新样本的轴标记为过期
+	 */
+	CvpEstimator(const int axis_num,const double alpha=0.5,const double beta=0.1,const double stale_time=0.02)
+		: axis_num_(axis_num),alpha_(alpha),beta_(beta),stale_time_(stale_time)
+	{
+		Reset();
+	}
+
+	/**
+	 * @brief 输入一帧反馈样本
+	 * @details 全部轴以同一时间戳修正，stamp不晚于已有样本的轴被忽略；第一帧样本直接作为估计状态
+	 *
+	 * @param[in] fb 反馈
+	 * @param[in] stamp 接收时间戳(单位:s，CLOCK_MONOTONIC时基)，来源于GetCvp(fb,stamp)、ResponseCvpRequest(fb,stamp)
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败，维数与轴数不一致
+	 */
+	int Update(const CvpData &fb,const double stamp)
+	{
+		if (fb.pos.size() != axis_num_ || fb.vel.size() != axis_num_ || fb.current.size() != axis_num_)
+		{
+			return -1;
+		}
+
+		std::lock_guard <std::mutex> lock(mutex_);
+		for (int i=0; i<axis_num_; i++)
+		{
+			UpdateAxis(i,fb.pos(i),fb.vel(i),fb.current(i),stamp);
+		}
+		return 0;
+	}
+
+	/**
+	 * @brief 输入部分执行器的一帧反馈样本
+	 * @details 仅修正index指定的轴，fb的第k个元素对应第index[k]个轴，与GetCvp(index,fb)的输出一致
+	 *
+	 * @param[in] index 执行器索引
+	 * @param[in] fb 反馈
+	 * @param[in] stamp 接收时间戳(单位:s，CLOCK_MONOTONIC时基)
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败，维数与索引个数不一致或索引越界
+	 */
+	int Update(const vector <int> &index,const CvpData &fb,const double stamp)
+	{
+		const long n = index.size();
+		if (fb.pos.size() != n || fb.vel.size() != n || fb.current.size() != n)
+		{
+			return -1;
+		}
+		for (long k=0; k<n; k++)
+		{
+			if (index[k] < 0 || index[k] >= axis_num_)
+			{
+				return -1;
+			}
+		}
+
+		std::lock_guard <std::mutex> lock(mutex_);
+		for (long k=0; k<n; k++)
+		{
+			UpdateAxis(index[k],fb.pos(k),fb.vel(k),fb.current(k),stamp);
+		}
+		return 0;
+	}
+
+	/**
+	 * @brief 获取t时刻的估计状态
+	 * @details 由最近一次修正后的位置、速度外推到t时刻
+	 *
+	 * @param[in] t 时刻(单位:s，CLOCK_MONOTONIC时基，见GetMonotonicTime)
+	 * @param[out] state 估计的位置和速度，current为最近一次样本；尚无样本的轴为0
+	 * @param[out] stale 各轴是否过期，尚无样本的轴视为过期
+	 * @return 执行成功与否
+	 *	 @retval 0 成功，所有轴均未过期
+	 *	 @retval -1 失败，存在过期的轴
+	 */
+	int GetState(const double t,CvpData &state,vector <bool> &stale)
+	{
+		int ret = 0;
+
+		state.pos.resize(axis_num_);
+		state.vel.resize(axis_num_);
+		state.current.resize(axis_num_);
+		stale.assign(axis_num_,true);
+
+		std::lock_guard <std::mutex> lock(mutex_);
+		for (int i=0; i<axis_num_; i++)
+		{
+			state.pos(i) = pos_(i) + vel_(i) * (t - stamp_(i));
+			state.vel(i) = vel_(i);
+			state.current(i) = current_(i);
+
+			if (!valid_[i])
+			{
+				state.pos(i) = 0.0;
+			}
+
+			stale[i] = !valid_[i] || t - stamp_(i) > stale_time_;
+			if (stale[i])
+			{
+				ret = -1;
+			}
+		}
+		return ret;
+	}
+
+	/**
+	 * @brief 清除所有样本与估计状态
+	 *
+	 */
+	void Reset()
+	{
+		std::lock_guard <std::mutex> lock(mutex_);
+		pos_ = Eigen::VectorXd::Zero(axis_num_);
+		vel_ = Eigen::VectorXd::Zero(axis_num_);
+		current_ = Eigen::VectorXd::Zero(axis_num_);
+		stamp_ = Eigen::VectorXd::Zero(axis_num_);
+		valid_.assign(axis_num_,false);
+	}
+};
+
+}
+
+#endif
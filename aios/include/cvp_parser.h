@@ -0,0 +1,229 @@
+#ifndef CVP_PARSER_H
+#define CVP_PARSER_H
+
+#include <locale.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "drive_api.h"
+
+namespace Amber{
+
+/**
+ * @brief JSON空白字符判断，不受当前locale影响
+ */
+inline bool IsJsonSpace(const char c)
+{
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/**
+ * @brief 十进制数字判断，不受当前locale影响
+ */
+inline bool IsJsonDigit(const char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+/**
+ * @brief 按"C" locale将字符串转换为浮点数，小数点始终为'.'
+ * @details locale对象在首次调用时创建一次，之后复用
+ */
+inline double StrtodC(const char *str,char **stop)
+{
+	static const locale_t c_locale = newlocale(LC_ALL_MASK,"C",(locale_t)0);
+	return strtod_l(str,stop,c_locale);
+}
+
+/**
+ * @brief 从应答报文中直接解析位置、速度和电流
+ * @details 独立的解析工具，直接在缓冲区上扫描并写入fb的第axis个元素，不构建Json::Value也不分配内存；
+ * 库内GetCvp等接口的接收路径仍使用Json::Reader，不经过本函数。解析不受进程locale影响。
+ * 接受的格式为单个扁平JSON对象(前后可有空白，末尾可有'\0'填充)：
+ * position、velocity、current须出现且为数值；status可选，出现时须为"OK"；
+ * 其余键(如reqTarget、method)的值为字符串、数值、true、false或null时跳过。
+ * 以下情况返回-1且fb不被修改，调用方应退回Json::Reader解析：键名含"error"、值为对象或数组、
+ * 上述字段缺失或类型不符、数值超过31个字符、格式不完整
+ *
+ * @param[in] buffer 应答报文
+ * @param[in] length 报文长度
+ * @param[out] fb 写入位置、速度和电流，pos、vel、current需已分配足够长度
+ * @param[in] axis 写入的元素序号
+ * @return 解析成功与否
+ *	 @retval 0 成功
+ *	 @retval -1 报文不符合上述格式
+ */
+inline int ParseCvpReply(const char *buffer,const size_t length,CvpData &fb,const int axis)
+{
+	const char *p = buffer;
+	const char *end = buffer + length;
+	double value[3];
+	bool found[3] = {false,false,false};
+	static const char *const kKeys[3] = {"position","velocity","current"};
+
+	while (end > p && (end[-1] == '\0' || IsJsonSpace(end[-1])))
+	{
+		end--;
+	}
+	while (p < end && IsJsonSpace(*p))
+	{
+		p++;
+	}
+	if (p == end || *p++ != '{' || end[-1] != '}')
+	{
+		return -1;
+	}
+	end--;
+
+	while (true)
+	{
+		while (p < end && IsJsonSpace(*p))
+		{
+			p++;
+		}
+		if (p == end)
+		{
+			break;
+		}
+
+		/* 键名 */
+		if (*p++ != '"')
+		{
+			return -1;
+		}
+		const char *key = p;
+		while (p < end && *p != '"')
+		{
+			p += (*p == '\\') ? 2 : 1;
+		}
+		if (p >= end)
+		{
+			return -1;
+		}
+		const size_t key_length = p - key;
+		p++;
+		while (p < end && IsJsonSpace(*p))
+		{
+			p++;
+		}
+		if (p == end || *p++ != ':')
+		{
+			return -1;
+		}
+		while (p < end && IsJsonSpace(*p))
+		{
+			p++;
+		}
+		if (p == end)
+		{
+			return -1;
+		}
+
+		for (size_t i=0; i+5<=key_length; i++)
+		{
+			if (strncmp(key + i,"error",5) == 0)
+			{
+				return -1;
+			}
+		}
+
+		int field = -1;
+		for (int i=0; i<3; i++)
+		{
+			if (key_length == strlen(kKeys[i]) && strncmp(key,kKeys[i],key_length) == 0)
+			{
+				field = i;
+			}
+		}
+
+		/* 值 */
+		if (*p == '"')
+		{
+			const char *str = ++p;
+			while (p < end && *p != '"')
+			{
+				p += (*p == '\\') ? 2 : 1;
+			}
+			if (p >= end || field >= 0)
+			{
+				return -1;
+			}
+			if (key_length == 6 && strncmp(key,"status",6) == 0 && (p - str != 2 || strncmp(str,"OK",2) != 0))
+			{
+				return -1;
+			}
+			p++;
+		}
+		else if (*p == '-' || IsJsonDigit(*p))
+		{
+			char number[32];
+			size_t n = 0;
+			while (p < end && (IsJsonDigit(*p) || *p == '-' || *p == '+' || *p == '.' || *p == 'e' || *p == 'E'))
+			{
+				if (n == sizeof(number) - 1)
+				{
+					return -1;
+				}
+				number[n++] = *p++;
+			}
+			number[n] = '\0';
+			char *stop;
+			const double v = StrtodC(number,&stop);
+			if (*stop != '\0')
+			{
+				return -1;
+			}
+			if (field >= 0)
+			{
+				value[field] = v;
+				found[field] = true;
+			}
+		}
+		else if (end - p >= 4 && (strncmp(p,"true",4) == 0 || strncmp(p,"null",4) == 0) && field < 0)
+		{
+			p += 4;
+		}
+		else if (end - p >= 5 && strncmp(p,"false",5) == 0 && field < 0)
+		{
+			p += 5;
+		}
+		else
+		{
+			return -1;
+		}
+
+		while (p < end && IsJsonSpace(*p))
+		{
+			p++;
+		}
+		if (p == end)
+		{
+			break;
+		}
+		if (*p++ != ',')
+		{
+			return -1;
+		}
+		while (p < end && IsJsonSpace(*p))
+		{
+			p++;
+		}
+		if (p == end)
+		{
+			return -1;
+		}
+	}
+
+	if (!found[0] || !found[1] || !found[2])
+	{
+		return -1;
+	}
+	fb.pos(axis) = value[0];
+	fb.vel(axis) = value[1];
+	fb.current(axis) = value[2];
+	return 0;
+}
+
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <string.h>
+#include <time.h>
 #include <vector>
 #include <jsoncpp/json/json.h> 
 #include <eigen3/Eigen/Dense>
@@ -55,8 +56,12 @@ public:
 	Eigen::VectorXd current;/**< 电流(单位:A) */
 };
 
+class ConfigCache;
+
 class AiosGroup final
 {
+	friend class ConfigCache;
+
 private:
 	int axis_num_;
 	vector <AiosAttribute> attribute_;
@@ -86,6 +91,8 @@ private:
 	int SetMotionControllerConfig(Eigen::VectorXd kp , vector <int> index,int mode);
 	int GetMotorConfig(Eigen::VectorXd &kp , vector <int> index,int mode);	
 	int SetMotorConfig(Eigen::VectorXd kp , vector <int> index,int mode);	
+	int CheckIndex(const vector <int> &index,const long size);
+	int IndexRequest(const vector <int> &index,const char *target,const char *key,const Eigen::VectorXd *value,CvpData *fb);
 
 public:
 	
@@ -94,6 +101,7 @@ public:
 	void Initialize(const vector <AiosAttribute> attribute);
 	void RequsestCvpFeedback();/* for real-time situation*/
 	int ResponseCvpRequest(	 CvpData &fb);
+	int ResponseCvpRequest(CvpData &fb,double &stamp);
 
 	int DisableVelocityRampMode();
 	int SetRampedVelocity(const Eigen::VectorXd vel,CvpData &fb);
@@ -123,6 +131,19 @@ public:
 	 */
 	vector <AiosAttribute> GetActuatorInfo();
 
+	/**
+	 * @brief 将轴组内的一个执行器重新绑定到新的执行器信息
+	 * @details 用于执行器更换或ip变化后原位恢复，只替换该轴的ip地址、序列号、mac地址和驱动状态，
+	 * 电机编号及其余轴的通信不受影响；通常在LookupMonitor的事件中调用
+	 * 
+	 * @param[in] index 执行器索引(从0开始，与GetActuatorInfo的顺序一致)
+	 * @param[in] attribute 新的执行器信息
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int Rebind(const int index,const AiosAttribute &attribute);
+
 	/**
 	 * @brief 获取当前位置
 	 * 
@@ -133,6 +154,18 @@ public:
 	 */
 	int GetPosition(Eigen::VectorXd &pos);
 
+	/**
+	 * @brief 获取当前位置
+	 * @details 仅访问index指定的执行器(索引不可重复)，数据按index的顺序排列
+	 * 
+	 * @param[in] index 执行器索引(从0开始，与GetActuatorInfo的顺序一致)
+	 * @param[out] pos 当前位置(单位:count)
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int GetPosition(const vector <int> index,Eigen::VectorXd &pos);
+
 	/**
 	 * @brief 获取当前速度
 	 * 
@@ -143,6 +176,18 @@ public:
 	 */
 	int GetVelocity(Eigen::VectorXd &vel);
 
+	/**
+	 * @brief 获取当前速度
+	 * @details 仅访问index指定的执行器(索引不可重复)，数据按index的顺序排列
+	 * 
+	 * @param[in] index 执行器索引(从0开始，与GetActuatorInfo的顺序一致)
+	 * @param[out] vel 当前速度(单位:count/s)
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int GetVelocity(const vector <int> index,Eigen::VectorXd &vel);
+
 	/**
 	 * @brief 获取当前电流
 	 * 
@@ -153,6 +198,18 @@ public:
 	 */
 	int GetCurrent(Eigen::VectorXd &current);
 
+	/**
+	 * @brief 获取当前电流
+	 * @details 仅访问index指定的执行器(索引不可重复)，数据按index的顺序排列
+	 * 
+	 * @param[in] index 执行器索引(从0开始，与GetActuatorInfo的顺序一致)
+	 * @param[out] current 当前电流(单位:A)
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int GetCurrent(const vector <int> index,Eigen::VectorXd &current);
+
 	/**
 	 * @brief 获取当前位置、速度和电流
 	 *
@@ -163,6 +220,32 @@ public:
 	 */
 	int GetCvp(	CvpData &fb );
 
+	/**
+	 * @brief 获取当前位置、速度和电流
+	 * @details 仅访问index指定的执行器(索引不可重复)，数据按index的顺序排列
+	 *
+	 * @param[in] index 执行器索引(从0开始，与GetActuatorInfo的顺序一致)
+	 * @param[out] fb 当前位置、速度和电流
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int GetCvp(const vector <int> index,CvpData &fb);
+
+	/**
+	 * @brief 获取当前位置、速度和电流及其接收时间戳
+	 * @details 时间戳在本端取得：库在一次调用内收齐所有轴的应答后才返回，各轴无法区分各自的到达时刻，
+	 * 因此整帧共用一个时间戳，取收齐应答后的单调时钟；各轴的实际采样时刻早于该值，相差不超过一次通信往返时间。
+	 * ResponseCvpRequest(fb,stamp)的时间戳含义相同
+	 *
+	 * @param[out] fb 当前位置、速度和电流
+	 * @param[out] stamp 接收时间戳(单位:s，CLOCK_MONOTONIC时基，见GetMonotonicTime)
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int GetCvp(CvpData &fb,double &stamp);
+
 	/**
 	 * @brief 获取aios轴组是否伺服使能的信息
 	 * 
@@ -211,6 +294,18 @@ public:
 	 */
 	int SetPosition(const Eigen::VectorXd pos);
 
+	/**
+	 * @brief 使轴组运动到目标位置
+	 * @details 仅访问index指定的执行器(索引不可重复)，数据按index的顺序排列
+	 * 
+	 * @param[in] index 执行器索引(从0开始，与GetActuatorInfo的顺序一致)
+	 * @param[in] pos 目标位置(单位:count)
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int SetPosition(const vector <int> index,const Eigen::VectorXd pos);
+
 	/**
 	 * @brief 使轴组运动到目标位置并返回当前位置、速度、电流
 	 * 
@@ -222,6 +317,19 @@ public:
 	 */
 	int SetPosition(const Eigen::VectorXd pos,CvpData &fb);
 
+	/**
+	 * @brief 使轴组运动到目标位置并返回当前位置、速度、电流
+	 * @details 仅访问index指定的执行器(索引不可重复)，数据按index的顺序排列
+	 * 
+	 * @param[in] index 执行器索引(从0开始，与GetActuatorInfo的顺序一致)
+	 * @param[in] pos 目标位置(单位:count)
+	 * @param[out] fb 当前位置、电流和速度
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int SetPosition(const vector <int> index,const Eigen::VectorXd pos,CvpData &fb);
+
 	/**
 	 * @brief 激活位置梯形加减速模式， 设置后SetPosition函数发送位置时，伺服底层会自动进行加减速
 	 * 
@@ -334,6 +442,18 @@ public:
 	 */
 	int SetVelocity(const Eigen::VectorXd vel);
 
+	/**
+	 * @brief 使执行器达到目标速度
+	 * @details 仅访问index指定的执行器(索引不可重复)，数据按index的顺序排列
+	 * 
+	 * @param[in] index 执行器索引(从0开始，与GetActuatorInfo的顺序一致)
+	 * @param[in] vel 目标速度(单位:count/s)
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int SetVelocity(const vector <int> index,const Eigen::VectorXd vel);
+
 	/**
 	 * @brief 使执行器达到目标速度
 	 * 
@@ -344,6 +464,18 @@ public:
 	 */
 	int SetVelocity(const Eigen::VectorXd vel,CvpData &fb);
 
+	/**
+	 * @brief 使执行器达到目标速度
+	 * @details 仅访问index指定的执行器(索引不可重复)，数据按index的顺序排列
+	 * 
+	 * @param[in] index 执行器索引(从0开始，与GetActuatorInfo的顺序一致)
+	 * @param[in] vel 目标速度(单位:count/s)
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int SetVelocity(const vector <int> index,const Eigen::VectorXd vel,CvpData &fb);
+
 	/**
 	 * @brief 使执行器达到目标电流
 	 * 
@@ -354,6 +486,18 @@ public:
 	 */
 	int SetCurrent(const Eigen::VectorXd current);
 
+	/**
+	 * @brief 使执行器达到目标电流
+	 * @details 仅访问index指定的执行器(索引不可重复)，数据按index的顺序排列
+	 * 
+	 * @param[in] index 执行器索引(从0开始，与GetActuatorInfo的顺序一致)
+	 * @param[in] current 目标电流(单位:A)
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int SetCurrent(const vector <int> index,const Eigen::VectorXd current);
+
 	/**
 	 * @brief 使执行器达到目标电流
 	 * 
@@ -364,6 +508,18 @@ public:
 	 */
 	int SetCurrent(const Eigen::VectorXd current,CvpData &fb);
 
+	/**
+	 * @brief 使执行器达到目标电流
+	 * @details 仅访问index指定的执行器(索引不可重复)，数据按index的顺序排列
+	 * 
+	 * @param[in] index 执行器索引(从0开始，与GetActuatorInfo的顺序一致)
+	 * @param[in] current 目标电流(单位:A)
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int SetCurrent(const vector <int> index,const Eigen::VectorXd current,CvpData &fb);
+
 	/**
 	 * @brief 执行器标定
 	 * 
@@ -393,6 +549,18 @@ public:
 	 */
 	int GetPostionKp(Eigen::VectorXd & kp);
 
+	/**
+	 * @brief 获取指定执行器位置环比例量
+	 * @details 仅访问index指定的执行器(索引不可重复)，数据按index的顺序排列
+	 * 
+	 * @param[in] index 执行器索引(从0开始，与GetActuatorInfo的顺序一致)
+	 * @param[out] kp 位置环比例量
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int GetPostionKp(const vector <int> index,Eigen::VectorXd & kp);
+
 	/**
 	 * @brief 获取指定执行器速度环比例量
 	 * 
@@ -403,6 +571,18 @@ public:
 	 */
 	int GetVelocityKp(Eigen::VectorXd &kp);
 
+	/**
+	 * @brief 获取指定执行器速度环比例量
+	 * @details 仅访问index指定的执行器(索引不可重复)，数据按index的顺序排列
+	 * 
+	 * @param[in] index 执行器索引(从0开始，与GetActuatorInfo的顺序一致)
+	 * @param[out] kp 速度环比例量
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int GetVelocityKp(const vector <int> index,Eigen::VectorXd &kp);
+
 	/**
 	 * @brief 获取指定执行器速度环积分量
 	 * 
@@ -413,6 +593,18 @@ public:
 	 */
 	int GetVelocityKi(Eigen::VectorXd &ki);
 
+	/**
+	 * @brief 获取指定执行器速度环积分量
+	 * @details 仅访问index指定的执行器(索引不可重复)，数据按index的顺序排列
+	 * 
+	 * @param[in] index 执行器索引(从0开始，与GetActuatorInfo的顺序一致)
+	 * @param[out] ki 速度环积分量
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int GetVelocityKi(const vector <int> index,Eigen::VectorXd &ki);
+
 	/**
 	 * @brief 获取指定执行器最大速度
 	 * 
@@ -423,6 +615,18 @@ public:
 	 */
 	int GetVelocityLimit(Eigen::VectorXd &limit);
 
+	/**
+	 * @brief 获取指定执行器最大速度
+	 * @details 仅访问index指定的执行器(索引不可重复)，数据按index的顺序排列
+	 * 
+	 * @param[in] index 执行器索引(从0开始，与GetActuatorInfo的顺序一致)
+	 * @param[out] limit 最大速度
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int GetVelocityLimit(const vector <int> index,Eigen::VectorXd &limit);
+
 	/**
 	 * @brief 设置指定执行器位置环比例量
 	 * 
@@ -433,6 +637,18 @@ public:
 	 */
 	int SetPostionKp(const Eigen::VectorXd kp);
 
+	/**
+	 * @brief 设置指定执行器位置环比例量
+	 * @details 仅访问index指定的执行器(索引不可重复)，数据按index的顺序排列
+	 * 
+	 * @param[in] index 执行器索引(从0开始，与GetActuatorInfo的顺序一致)
+	 * @param[in] kp 位置环比例量
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int SetPostionKp(const vector <int> index,const Eigen::VectorXd kp);
+
 	/**
 	 * @brief 设置指定执行器速度环比例量
 	 * 
@@ -443,6 +659,18 @@ public:
 	 */
 	int SetVelocityKp(const Eigen::VectorXd kp);
 
+	/**
+	 * @brief 设置指定执行器速度环比例量
+	 * @details 仅访问index指定的执行器(索引不可重复)，数据按index的顺序排列
+	 * 
+	 * @param[in] index 执行器索引(从0开始，与GetActuatorInfo的顺序一致)
+	 * @param[in] kp 速度环比例量
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int SetVelocityKp(const vector <int> index,const Eigen::VectorXd kp);
+
 	/**
 	 * @brief 设置指定执行器速度环积分量
 	 * 
@@ -453,6 +681,18 @@ public:
 	 */
 	int SetVelocityKi(const Eigen::VectorXd ki);
 
+	/**
+	 * @brief 设置指定执行器速度环积分量
+	 * @details 仅访问index指定的执行器(索引不可重复)，数据按index的顺序排列
+	 * 
+	 * @param[in] index 执行器索引(从0开始，与GetActuatorInfo的顺序一致)
+	 * @param[in] ki 速度环积分量
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int SetVelocityKi(const vector <int> index,const Eigen::VectorXd ki);
+
 	/**
 	 * @brief 设置指定执行器最大速度
 	 * 
@@ -463,6 +703,18 @@ public:
 	 */
 	int SetVelocityLimit(const Eigen::VectorXd limit);
 
+	/**
+	 * @brief 设置指定执行器最大速度
+	 * @details 仅访问index指定的执行器(索引不可重复)，数据按index的顺序排列
+	 * 
+	 * @param[in] index 执行器索引(从0开始，与GetActuatorInfo的顺序一致)
+	 * @param[in] limit 最大速度
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int SetVelocityLimit(const vector <int> index,const Eigen::VectorXd limit);
+
 	/**
 	 * @brief 获取指定执行器最大电流
 	 * 
@@ -473,6 +725,18 @@ public:
 	 */
 	int GetCurrentLimit(Eigen::VectorXd &limit);
 
+	/**
+	 * @brief 获取指定执行器最大电流
+	 * @details 仅访问index指定的执行器(索引不可重复)，数据按index的顺序排列
+	 * 
+	 * @param[in] index 执行器索引(从0开始，与GetActuatorInfo的顺序一致)
+	 * @param[out] limit 最大电流
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int GetCurrentLimit(const vector <int> index,Eigen::VectorXd &limit);
+
 	/**
 	 * @brief 获取指定执行器最大电流环带宽
 	 * 
@@ -483,6 +747,18 @@ public:
 	 */
 	int GetCurrentBandwidth(Eigen::VectorXd &bandwidth);
 
+	/**
+	 * @brief 获取指定执行器最大电流环带宽
+	 * @details 仅访问index指定的执行器(索引不可重复)，数据按index的顺序排列
+	 * 
+	 * @param[in] index 执行器索引(从0开始，与GetActuatorInfo的顺序一致)
+	 * @param[out] bandwidth 最大电流环带宽
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int GetCurrentBandwidth(const vector <int> index,Eigen::VectorXd &bandwidth);
+
 	/**
 	 * @brief 设置指定执行器最大电流
 	 * 
@@ -493,6 +769,18 @@ public:
 	 */
 	int SetCurrentLimit(const Eigen::VectorXd limit);
 
+	/**
+	 * @brief 设置指定执行器最大电流
+	 * @details 仅访问index指定的执行器(索引不可重复)，数据按index的顺序排列
+	 * 
+	 * @param[in] index 执行器索引(从0开始，与GetActuatorInfo的顺序一致)
+	 * @param[in] limit 最大电流
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int SetCurrentLimit(const vector <int> index,const Eigen::VectorXd limit);
+
 	/**
 	 * @brief 设置指定执行器最大电流环带宽
 	 * 
@@ -503,6 +791,18 @@ public:
 	 */
 	int SetCurrentBandwidth(const Eigen::VectorXd bandwidth);
 
+	/**
+	 * @brief 设置指定执行器最大电流环带宽
+	 * @details 仅访问index指定的执行器(索引不可重复)，数据按index的顺序排列
+	 * 
+	 * @param[in] index 执行器索引(从0开始，与GetActuatorInfo的顺序一致)
+	 * @param[in] bandwidth 最大电流环带宽
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int SetCurrentBandwidth(const vector <int> index,const Eigen::VectorXd bandwidth);
+
 	/**
 	 * @brief 清除修改的配置
 	 * @details 有效区域为设置PID以及加减速参数设置
@@ -652,12 +952,267 @@ public:
 	std::shared_ptr <AiosGroup> GetHandlesFromMacAddressList(const std::vector <string> mac_address);
 };
 
+/**
+ * @brief 获取单调时钟时间，与GetCvp返回的时间戳同一时基
+ * @return 时间(单位:s)
+ */
+inline double GetMonotonicTime()
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC,&t);
+	return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
 /**
  * @brief 获取系统错误
  * @return 错误描述
  */
 string GetSystemError();
 
+inline int AiosGroup::CheckIndex(const vector <int> &index,const long size)
+{
+	if (index.empty() || (size >= 0 && size != (long)index.size()))
+	{
+		return -1;
+	}
+
+	vector <bool> used(axis_num_,false);
+	for (size_t k=0; k<index.size(); k++)
+	{
+		if (index[k] < 0 || index[k] >= axis_num_ || used[index[k]])
+		{
+			return -1;
+		}
+		used[index[k]] = true;
+	}
+	return 0;
+}
+
+/*
+ * 按index逐轴发送端口2333上的循环指令，报文与整组函数相同；
+ * fb非空时请求应答(reply_enable)并按index的顺序写入fb，value为空时发送CVP查询
+ */
+inline int AiosGroup::IndexRequest(const vector <int> &index,const char *target,const char *key,const Eigen::VectorXd *value,CvpData *fb)
+{
+	if (CheckIndex(index,value ? value->size() : -1) != 0)
+	{
+		return -1;
+	}
+
+	const size_t n = index.size();
+	vector <Json::Value> send_data(n);
+	for (size_t k=0; k<n; k++)
+	{
+		Json::Value &data = send_data[k];
+		data["reqTarget"] = string(m_list_.at(index[k]) == 0 ? "/m0/" : "/m1/") + target;
+		if (value == NULL)
+		{
+			data["method"] = "GET";
+			continue;
+		}
+
+		data["method"] = "SET";
+		data["reply_enable"] = (fb != NULL);
+		data[key] = (*value)(k);
+		if (strcmp(key,"current") != 0)
+		{
+			data["current_ff"] = 0;
+		}
+		if (strcmp(key,"position") == 0)
+		{
+			data["velocity_ff"] = 0;
+		}
+	}
+
+	SendTo(index,send_data.data(),2333);
+	if (fb == NULL)
+	{
+		return 0;
+	}
+
+	vector <Json::Value> recv_data(n);
+	RecvFrom(index,recv_data.data(),2333);
+	fb->pos.resize(n);
+	fb->vel.resize(n);
+	fb->current.resize(n);
+	for (size_t k=0; k<n; k++)
+	{
+		const Json::Value &data = recv_data[k];
+		if (!data.isObject() || !data["position"].isNumeric() || !data["velocity"].isNumeric() || !data["current"].isNumeric())
+		{
+			return -1;
+		}
+		fb->pos(k) = data["position"].asDouble();
+		fb->vel(k) = data["velocity"].asDouble();
+		fb->current(k) = data["current"].asDouble();
+	}
+	return 0;
+}
+
+inline int AiosGroup::GetCvp(const vector <int> index,CvpData &fb)
+{
+	return IndexRequest(index,"CVP",NULL,NULL,&fb);
+}
+
+inline int AiosGroup::GetPosition(const vector <int> index,Eigen::VectorXd &pos)
+{
+	CvpData fb;
+	if (GetCvp(index,fb) != 0)
+	{
+		return -1;
+	}
+	pos = fb.pos;
+	return 0;
+}
+
+inline int AiosGroup::GetVelocity(const vector <int> index,Eigen::VectorXd &vel)
+{
+	CvpData fb;
+	if (GetCvp(index,fb) != 0)
+	{
+		return -1;
+	}
+	vel = fb.vel;
+	return 0;
+}
+
+inline int AiosGroup::GetCurrent(const vector <int> index,Eigen::VectorXd &current)
+{
+	CvpData fb;
+	if (GetCvp(index,fb) != 0)
+	{
+		return -1;
+	}
+	current = fb.current;
+	return 0;
+}
+
+inline int AiosGroup::SetPosition(const vector <int> index,const Eigen::VectorXd pos)
+{
+	return IndexRequest(index,"setPosition","position",&pos,NULL);
+}
+
+inline int AiosGroup::SetPosition(const vector <int> index,const Eigen::VectorXd pos,CvpData &fb)
+{
+	return IndexRequest(index,"setPosition","position",&pos,&fb);
+}
+
+inline int AiosGroup::SetVelocity(const vector <int> index,const Eigen::VectorXd vel)
+{
+	return IndexRequest(index,"setVelocity","velocity",&vel,NULL);
+}
+
+inline int AiosGroup::SetVelocity(const vector <int> index,const Eigen::VectorXd vel,CvpData &fb)
+{
+	return IndexRequest(index,"setVelocity","velocity",&vel,&fb);
+}
+
+inline int AiosGroup::SetCurrent(const vector <int> index,const Eigen::VectorXd current)
+{
+	return IndexRequest(index,"setCurrent","current",&current,NULL);
+}
+
+inline int AiosGroup::SetCurrent(const vector <int> index,const Eigen::VectorXd current,CvpData &fb)
+{
+	return IndexRequest(index,"setCurrent","current",&current,&fb);
+}
+
+/* 配置读写沿用库内按index访问的接口，mode与整组函数一致 */
+inline int AiosGroup::GetPostionKp(const vector <int> index,Eigen::VectorXd & kp)
+{
+	return CheckIndex(index,-1) != 0 ? -1 : GetMotionControllerConfig(kp,index,0);
+}
+
+inline int AiosGroup::GetVelocityKp(const vector <int> index,Eigen::VectorXd &kp)
+{
+	return CheckIndex(index,-1) != 0 ? -1 : GetMotionControllerConfig(kp,index,1);
+}
+
+inline int AiosGroup::GetVelocityKi(const vector <int> index,Eigen::VectorXd &ki)
+{
+	return CheckIndex(index,-1) != 0 ? -1 : GetMotionControllerConfig(ki,index,2);
+}
+
+inline int AiosGroup::GetVelocityLimit(const vector <int> index,Eigen::VectorXd &limit)
+{
+	return CheckIndex(index,-1) != 0 ? -1 : GetMotionControllerConfig(limit,index,3);
+}
+
+inline int AiosGroup::SetPostionKp(const vector <int> index,const Eigen::VectorXd kp)
+{
+	return CheckIndex(index,kp.size()) != 0 ? -1 : SetMotionControllerConfig(kp,index,0);
+}
+
+inline int AiosGroup::SetVelocityKp(const vector <int> index,const Eigen::VectorXd kp)
+{
+	return CheckIndex(index,kp.size()) != 0 ? -1 : SetMotionControllerConfig(kp,index,1);
+}
+
+inline int AiosGroup::SetVelocityKi(const vector <int> index,const Eigen::VectorXd ki)
+{
+	return CheckIndex(index,ki.size()) != 0 ? -1 : SetMotionControllerConfig(ki,index,2);
+}
+
+inline int AiosGroup::SetVelocityLimit(const vector <int> index,const Eigen::VectorXd limit)
+{
+	return CheckIndex(index,limit.size()) != 0 ? -1 : SetMotionControllerConfig(limit,index,3);
+}
+
+inline int AiosGroup::GetCurrentLimit(const vector <int> index,Eigen::VectorXd &limit)
+{
+	return CheckIndex(index,-1) != 0 ? -1 : GetMotorConfig(limit,index,0);
+}
+
+inline int AiosGroup::GetCurrentBandwidth(const vector <int> index,Eigen::VectorXd &bandwidth)
+{
+	return CheckIndex(index,-1) != 0 ? -1 : GetMotorConfig(bandwidth,index,5);
+}
+
+inline int AiosGroup::SetCurrentLimit(const vector <int> index,const Eigen::VectorXd limit)
+{
+	return CheckIndex(index,limit.size()) != 0 ? -1 : SetMotorConfig(limit,index,0);
+}
+
+inline int AiosGroup::SetCurrentBandwidth(const vector <int> index,const Eigen::VectorXd bandwidth)
+{
+	return CheckIndex(index,bandwidth.size()) != 0 ? -1 : SetMotorConfig(bandwidth,index,5);
+}
+
+inline int AiosGroup::ResponseCvpRequest(CvpData &fb,double &stamp)
+{
+	const int ret = ResponseCvpRequest(fb);
+	stamp = GetMonotonicTime();
+	return ret;
+}
+
+inline int AiosGroup::GetCvp(CvpData &fb,double &stamp)
+{
+	RequsestCvpFeedback();
+	return ResponseCvpRequest(fb,stamp);
+}
+
+inline int AiosGroup::Rebind(const int index,const AiosAttribute &attribute)
+{
+	if (index < 0 || index >= axis_num_ || attribute.ip_.empty())
+	{
+		return -1;
+	}
+
+	/* 只替换识别信息，电机编号与名称保持不变 */
+	AiosAttribute &bound = attribute_.at(index);
+	bound.ip_ = attribute.ip_;
+	bound.mac_address_ = attribute.mac_address_;
+	bound.serial_number_ = attribute.serial_number_;
+	bound.fw_version_ = attribute.fw_version_;
+	bound.hw_version_ = attribute.hw_version_;
+	bound.drive_status_ = attribute.drive_status_;
+	ip_list_.at(index) = attribute.ip_;
+	serial_number_list_.at(index) = attribute.serial_number_;
+	mac_address_list_.at(index) = attribute.mac_address_;
+	drive_status_.at(index) = attribute.drive_status_;
+	return 0;
+}
+
 }
 
 #endif
@@ -0,0 +1,220 @@
+#ifndef GROUP_RECORD_H
+#define GROUP_RECORD_H
+
+#include <time.h>
+#include <fstream>
+
+#include "drive_api.h"
+
+namespace Amber{
+
+/**
+ * @brief 同时录制多个aios轴组的运动轨迹，可通过ReplayGroups播放
+ * @details 所有轴组共用库内同一个通信端口，因此每个采样时刻依次对各轴组执行GetCvp(fb,stamp)，
+ * 前一个轴组的应答接收完再查询下一个，各轴组带各自的接收时间戳。
+ * 文件第一行为"AIOS_GROUPS 轴组数 各轴组轴数"，之后每行依次为各轴组的"时间(单位:s) 位置(单位:count)"，
+ * 时间相对第一行第一个轴组，与单轴组的轨迹文件不通用。
+ * 某一时刻任一轴组读取失败时跳过该时刻并计入lost，已采集的轨迹保留。
+ * 以Motion的停止信号控制：开始时清除，可通过多线程执行函数Motion::SetStopSignal()停止运行，停止后写入文件。
+ * 库中Motion的成员只能由库定义，因此以自由函数提供而非Motion::RecordPoint的重载
+ *
+ * @param[in] group_list 轴组对象列表，播放时须按相同顺序传入
+ * @param[in] file_path 轨迹文件路径，默认为"data.rpd"
+ * @param[out] lost 跳过的采样时刻数，可为NULL
+ * @return 执行成功与否
+ *	 @retval 0 成功
+ *	 @retval -1 失败，轴组为空、没有采集到有效样本或文件无法写入
+ */
+inline int RecordGroups(const vector <AiosGroup *> &group_list,const std::string file_path="data.rpd",unsigned int *lost=NULL)
+{
+	const unsigned int n = group_list.size();
+	if (n == 0)
+	{
+		return -1;
+	}
+	for (unsigned int g=0; g<n; g++)
+	{
+		if (group_list[g] == NULL)
+		{
+			return -1;
+		}
+	}
+
+	vector <Eigen::VectorXd> row;
+	vector <CvpData> fb(n);
+	vector <double> stamp(n);
+	double start = 0.0;
+	unsigned int skipped = 0;
+	long width = 0;
+
+	for (unsigned int g=0; g<n; g++)
+	{
+		const int axes = group_list[g]->Size();
+		fb[g].pos = Eigen::VectorXd::Zero(axes);
+		fb[g].vel = Eigen::VectorXd::Zero(axes);
+		fb[g].current = Eigen::VectorXd::Zero(axes);
+		width += 1 + axes;
+	}
+
+	Motion::InitStopSignal();
+	while (!Motion::GetStopSignal())
+	{
+		bool ok = true;
+		for (unsigned int g=0; g<n && ok; g++)
+		{
+			ok = group_list[g]->GetCvp(fb[g],stamp[g]) == 0 && fb[g].pos.size() == group_list[g]->Size();
+		}
+		if (!ok)
+		{
+			skipped++;
+			continue;
+		}
+
+		if (row.empty())
+		{
+			start = stamp[0];
+		}
+		row.push_back(Eigen::VectorXd(width));
+		for (unsigned int g=0,offset=0; g<n; g++)
+		{
+			row.back()(offset) = stamp[g] - start;
+			row.back().segment(offset + 1,fb[g].pos.size()) = fb[g].pos;
+			offset += 1 + fb[g].pos.size();
+		}
+	}
+
+	if (lost != NULL)
+	{
+		*lost = skipped;
+	}
+	if (row.empty())
+	{
+		return -1;
+	}
+
+	std::ofstream out(file_path.c_str());
+	if (!out.is_open())
+	{
+		return -1;
+	}
+	out.precision(9);
+	out << "AIOS_GROUPS " << n;
+	for (unsigned int g=0; g<n; g++)
+	{
+		out << " " << group_list[g]->Size();
+	}
+	out << "\n";
+	for (unsigned int k=0; k<row.size(); k++)
+	{
+		for (long j=0; j<row[k].size(); j++)
+		{
+			out << (j == 0 ? "" : " ") << row[k](j);
+		}
+		out << "\n";
+	}
+	return out.good() ? 0 : -1;
+}
+
+/**
+ * @brief 同时播放RecordGroups录制的多轴组轨迹
+ * @details 每次循环先依次用Motion::MoveTo将各轴组运行到轨迹起点，再按录制时各轴组各自的时间戳逐点下发位置设定值(不等待应答)，
+ * 保留录制时轴组之间的时间偏差。任一轴组下发失败时立即返回-1。
+ * 以Motion的停止信号控制：开始时清除，可通过多线程执行函数Motion::SetStopSignal()停止运行
+ *
+ * @param[in] group_list 轴组对象列表，顺序与录制时一致
+ * @param[in] file_path 轨迹文件路径，默认为"data.rpd",来源于RecordGroups存储的轨迹文件
+ * @param[in] count 循环次数，0表示无限循环
+ * @return 执行成功与否
+ *	 @retval 0 成功
+ *	 @retval -1 失败，轴组个数或轴数与轨迹文件不一致、文件格式错误、运行到起点失败或下发位置失败
+ */
+inline int ReplayGroups(const vector <AiosGroup *> &group_list,const std::string file_path="data.rpd",const unsigned int count=0)
+{
+	const unsigned int n = group_list.size();
+	if (n == 0)
+	{
+		return -1;
+	}
+	for (unsigned int g=0; g<n; g++)
+	{
+		if (group_list[g] == NULL)
+		{
+			return -1;
+		}
+	}
+
+	std::ifstream in(file_path.c_str());
+	string magic;
+	unsigned int groups = 0;
+	if (!(in >> magic >> groups) || magic != "AIOS_GROUPS" || groups != n)
+	{
+		return -1;
+	}
+
+	vector <int> axes(n);
+	vector <int> offset(n);
+	int width = 0;
+	for (unsigned int g=0; g<n; g++)
+	{
+		if (!(in >> axes[g]) || axes[g] != group_list[g]->Size())
+		{
+			return -1;
+		}
+		offset[g] = width;
+		width += 1 + axes[g];
+	}
+
+	vector <Eigen::VectorXd> row;
+	double value;
+	while (in >> value)
+	{
+		row.push_back(Eigen::VectorXd(width));
+		row.back()(0) = value;
+		for (int j=1; j<width; j++)
+		{
+			if (!(in >> row.back()(j)))
+			{
+				return -1;
+			}
+		}
+	}
+	if (row.empty() || !in.eof())
+	{
+		return -1;
+	}
+
+	Motion::InitStopSignal();
+	for (unsigned int loop=0; (count == 0 || loop < count) && !Motion::GetStopSignal(); loop++)
+	{
+		for (unsigned int g=0; g<n; g++)
+		{
+			if (Motion::MoveTo(group_list[g],row[0].segment(offset[g] + 1,axes[g])) != 0)
+			{
+				return -1;
+			}
+		}
+
+		const double start = GetMonotonicTime() - row[0](0);
+		for (unsigned int k=0; k<row.size() && !Motion::GetStopSignal(); k++)
+		{
+			for (unsigned int g=0; g<n; g++)
+			{
+				const double deadline = start + row[k](offset[g]);
+				struct timespec ts;
+				ts.tv_sec = (time_t)deadline;
+				ts.tv_nsec = (long)((deadline - ts.tv_sec) * 1e9);
+				clock_nanosleep(CLOCK_MONOTONIC,TIMER_ABSTIME,&ts,NULL);
+
+				if (group_list[g]->SetPosition(row[k].segment(offset[g] + 1,axes[g])) != 0)
+				{
+					return -1;
+				}
+			}
+		}
+	}
+	return 0;
+}
+
+}
+
+#endif
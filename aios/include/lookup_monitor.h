@@ -0,0 +1,303 @@
+#ifndef LOOKUP_MONITOR_H
+#define LOOKUP_MONITOR_H
+
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "drive_api.h"
+
+namespace Amber{
+
+enum LookupEventType
+{
+	kActuatorJoin = 1,/**< 新执行器加入网络 */
+	kActuatorLeave = 2,/**< 执行器离开网络 */
+	kActuatorIpChange = 3,/**< 执行器ip地址变化 */
+};
+
+class LookupEvent
+{
+public:
+	LookupEventType type_;/**< 事件类型 */
+	AiosAttribute attribute_;/**< 执行器信息，以序列号区分执行器 */
+	std::string old_ip_;/**< 变化前的ip地址，仅kActuatorIpChange有效 */
+};
+
+/**
+ * @brief 执行器上下线事件回调，在监测线程中调用
+ */
+typedef std::function <void(const LookupEvent &)> LookupEventCallback;
+
+/**
+ * @brief 后台热插拔监测
+ * @details 使用独立的套接字，每个周期向广播地址发送一次发现请求并在周期内收集应答，按序列号与上一次的结果比较，
+ * 产生加入、离开和ip变化事件；连续miss_limit个周期没有应答的执行器视为离开。
+ * 执行器只应答发现请求，不主动广播上线或下线，因此无法被动监听，只能以较低频率主动探测，每个周期只发送一个广播报文。
+ * 不经过Lookup及AiosGroup的套接字，不影响已有轴组的通信，ip变化或执行器更换后可用AiosGroup::Rebind原位恢复
+ */
+class LookupMonitor
+{
+private:
+	class Entry
+	{
+	public:
+		AiosAttribute attribute;
+		unsigned int miss;
+	};
+
+	std::string address_;
+	int socket_;
+	unsigned int period_;
+	unsigned int miss_limit_;
+	LookupEventCallback callback_;
+	std::mutex mutex_;
+	std::map <std::string,Entry> actuators_;
+	std::atomic <bool> running_;
+	std::thread thread_;
+
+	/* AiosAttribute只声明了赋值运算符，事件在deque中原位构造后赋值，避免复制构造 */
+	static void Notify(std::deque <LookupEvent> &events,const LookupEventType type,const AiosAttribute &attribute,const std::string old_ip="")
+	{
+		events.emplace_back();
+		LookupEvent &event = events.back();
+		event.type_ = type;
+		event.attribute_ = attribute;
+		event.old_ip_ = old_ip;
+	}
+
+	/* 发送一次发现请求，在一个周期内收集应答 */
+	void Probe(std::map <std::string,AiosAttribute> &found)
+	{
+		const char request[] = "Is any AIOS server here?";
+		struct sockaddr_in addr;
+		memset(&addr,0,sizeof(addr));
+		addr.sin_family = AF_INET;
+		addr.sin_port = htons(2334);
+		inet_pton(AF_INET,address_.c_str(),&addr.sin_addr);
+		sendto(socket_,request,strlen(request),0,(struct sockaddr *)&addr,sizeof(addr));
+
+		const double deadline = GetMonotonicTime() + period_ * 1e-3;
+		struct pollfd fd = {socket_,POLLIN,0};
+		char buffer[1024];
+		Json::Reader reader;
+
+		for (double now = GetMonotonicTime(); running_ && now < deadline; now = GetMonotonicTime())
+		{
+			int timeout = std::min(10,(int)((deadline - now) * 1e3) + 1);
+			if (poll(&fd,1,timeout) <= 0)
+			{
+				continue;
+			}
+
+			struct sockaddr_in from;
+			socklen_t from_len = sizeof(from);
+			ssize_t len = recvfrom(socket_,buffer,sizeof(buffer),0,(struct sockaddr *)&from,&from_len);
+			Json::Value reply;
+			if (len <= 0 || !reader.parse(buffer,buffer + strnlen(buffer,len),reply) || !reply.isObject() ||
+				!reply["serial_number"].isString())
+			{
+				continue;
+			}
+
+			char ip[INET_ADDRSTRLEN];
+			inet_ntop(AF_INET,&from.sin_addr,ip,sizeof(ip));
+
+			AiosAttribute attribute;
+			attribute.ip_ = ip;
+			attribute.mac_address_ = reply["mac_address"].asString();
+			attribute.serial_number_ = reply["serial_number"].asString();
+			attribute.fw_version_ = reply["Fw_version"].asString();
+			attribute.hw_version_ = reply["Hw_version"].asString();
+			attribute.m_ = 0;
+			attribute.id_ = 0;
+			attribute.drive_status_ = reply["motor_drive_ready"].asBool();
+			found[attribute.serial_number_] = attribute;
+		}
+	}
+
+	void Run()
+	{
+		while (running_)
+		{
+			std::map <std::string,AiosAttribute> found;
+			std::deque <LookupEvent> events;
+
+			Probe(found);
+			if (!running_)
+			{
+				break;
+			}
+
+			{
+				std::lock_guard <std::mutex> lock(mutex_);
+
+				for (auto it = found.begin(); it != found.end(); it++)
+				{
+					auto known = actuators_.find(it->first);
+					if (known == actuators_.end())
+					{
+						Entry entry;
+						entry.attribute = it->second;
+						entry.miss = 0;
+						actuators_[it->first] = entry;
+						Notify(events,kActuatorJoin,it->second);
+						continue;
+					}
+
+					std::string old_ip = known->second.attribute.ip_;
+					known->second.attribute = it->second;
+					known->second.miss = 0;
+					if (old_ip != it->second.ip_)
+					{
+						Notify(events,kActuatorIpChange,it->second,old_ip);
+					}
+				}
+
+				for (auto it = actuators_.begin(); it != actuators_.end(); )
+				{
+					if (found.count(it->first) == 0 && ++it->second.miss >= miss_limit_)
+					{
+						Notify(events,kActuatorLeave,it->second.attribute);
+						it = actuators_.erase(it);
+						continue;
+					}
+					it++;
+				}
+			}
+
+			for (size_t i=0; i<events.size(); i++)
+			{
+				callback_(events[i]);
+			}
+		}
+	}
+
+public:
+
+	/**
+	 * @brief 构造热插拔监测
+	 *
+	 * @param[in] address 发现请求的广播地址，与Lookup一致为10.0.0.255
+	 */
+	LookupMonitor(const std::string address="10.0.0.255")
+		: address_(address),socket_(-1),period_(1000),miss_limit_(3),running_(false)
+	{
+	}
+
+	~LookupMonitor()
+	{
+		Stop();
+	}
+
+	/**
+	 * @brief 启动后台热插拔监测
+	 * @details 第一个周期内应答的执行器均产生加入事件
+	 *
+	 * @param[in] callback 事件回调
+	 * @param[in] period 探测周期(单位:ms)
+	 * @param[in] miss_limit 判定离开所需的连续无应答周期数
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败，监测已在运行、参数为0、在回调中调用或套接字打开失败
+	 */
+	int Start(LookupEventCallback callback,const unsigned int period=1000,const unsigned int miss_limit=3)
+	{
+		int on = 1;
+
+		if (running_ || !callback || period == 0 || miss_limit == 0)
+		{
+			return -1;
+		}
+
+		/* 回收在回调中停止的监测线程，在回调中重新启动时失败 */
+		Stop();
+		if (thread_.joinable())
+		{
+			return -1;
+		}
+
+		socket_ = socket(AF_INET,SOCK_DGRAM,0);
+		if (socket_ < 0 || setsockopt(socket_,SOL_SOCKET,SO_BROADCAST,&on,sizeof(on)) < 0)
+		{
+			Stop();
+			return -1;
+		}
+
+		callback_ = callback;
+		period_ = period;
+		miss_limit_ = miss_limit;
+		actuators_.clear();
+		running_ = true;
+		thread_ = std::thread(&LookupMonitor::Run,this);
+		return 0;
+	}
+
+	/**
+	 * @brief 停止后台热插拔监测，等待回调返回
+	 * @details 在回调中调用时只通知监测线程退出并立即返回，线程在回调返回后结束，由之后的Start、Stop或析构回收
+	 * @attention 不能在回调中析构本对象
+	 *
+	 */
+	void Stop()
+	{
+		running_ = false;
+
+		if (thread_.joinable() && thread_.get_id() == std::this_thread::get_id())
+		{
+			return;
+		}
+
+		if (thread_.joinable())
+		{
+			thread_.join();
+		}
+
+		if (socket_ >= 0)
+		{
+			close(socket_);
+			socket_ = -1;
+		}
+	}
+
+	/**
+	 * @brief 读取后台热插拔监测是否运行
+	 *
+	 * @return 是否运行
+	 *	 @retval true 运行中
+	 *	 @retval false 未运行
+	 */
+	bool GetStatus()
+	{
+		return running_;
+	}
+
+	/**
+	 * @brief 获取当前在线的执行器信息
+	 *
+	 * @return 按序列号排序的执行器信息
+	 */
+	vector <AiosAttribute> GetActuatorInfo()
+	{
+		vector <AiosAttribute> info;
+		std::lock_guard <std::mutex> lock(mutex_);
+		for (auto it = actuators_.begin(); it != actuators_.end(); it++)
+		{
+			info.push_back(it->second.attribute);
+		}
+		return info;
+	}
+};
+
+}
+
+#endif
@@ -0,0 +1,333 @@
+#ifndef MOTION_HANDLE_H
+#define MOTION_HANDLE_H
+
+#include <math.h>
+#include <time.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "drive_api.h"
+
+namespace Amber{
+
+/**
+ * @brief 可在运动中修改目标点的运动句柄
+ * @details 后台线程以固定周期在本端逐轴生成位置设定值并通过SetPosition下发：每个周期按剩余距离、最大速度、
+ * 最大加速度和最大减速度计算下一设定点，以当前的设定位置和速度为初始状态，因此修改目标点在下一个周期生效，运动不停止。
+ * 各轴独立地以限制内最快的速度到达目标点，不做多轴同时到达；不限制加加速度。
+ * 某个周期超时时不补发错过的设定点，下一个设定点仍按原周期网格下发。
+ * 运动期间不要在其他线程中访问同一轴组
+ */
+class MotionHandle
+{
+private:
+	AiosGroup *group_;
+	double period_;
+
+	std::mutex mutex_;
+	Eigen::VectorXd target_;
+	ProfileParameters para_;
+
+	std::atomic <bool> stop_;
+	std::atomic <bool> finished_;
+	int result_;
+	std::thread thread_;
+
+	/* CLOCK_MONOTONIC时间(单位:ns) */
+	static long long Now()
+	{
+		struct timespec ts;
+		clock_gettime(CLOCK_MONOTONIC,&ts);
+		return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+	}
+
+	void Run(Eigen::VectorXd pos)
+	{
+		Eigen::VectorXd vel = Eigen::VectorXd::Zero(pos.size());
+		Eigen::VectorXd target;
+		ProfileParameters para;
+
+		const long long step = (long long)(period_ * 1e9);
+		long long deadline = Now();
+
+		result_ = -1;
+
+		while (true)
+		{
+			{
+				std::lock_guard <std::mutex> lock(mutex_);
+				target = target_;
+				para = para_;
+			}
+
+			const bool stop = stop_ || Motion::GetStopSignal();
+			bool done = true;
+
+			for (int i=0; i<pos.size(); i++)
+			{
+				done &= Step(pos(i),vel(i),target(i),para.vel(i),para.acc(i),para.dec(i),period_,stop);
+			}
+
+			if (group_->SetPosition(pos) == -1)
+			{
+				break;
+			}
+
+			if (done)
+			{
+				result_ = stop ? -1 : 0;
+				break;
+			}
+
+			/* 超过截止时间的周期不补发，截止时间跳到当前时刻之后的下一个周期点 */
+			deadline += step;
+			const long long now = Now();
+			if (now > deadline)
+			{
+				deadline += (now - deadline) / step * step + step;
+			}
+
+			struct timespec ts;
+			ts.tv_sec = deadline / 1000000000LL;
+			ts.tv_nsec = deadline % 1000000000LL;
+			clock_nanosleep(CLOCK_MONOTONIC,TIMER_ABSTIME,&ts,NULL);
+		}
+
+		finished_ = true;
+	}
+
+public:
+
+	/**
+	 * @brief 检查加减速参数的维数为size且各项为正
+	 *
+	 * @return 检查结果
+	 *	 @retval 0 合法
+	 *	 @retval -1 不合法
+	 */
+	static int CheckParameters(const ProfileParameters &para,const long size)
+	{
+		if (para.acc.size() != size || para.dec.size() != size || para.vel.size() != size)
+		{
+			return -1;
+		}
+		if ((para.acc.array() <= 0).any() || (para.dec.array() <= 0).any() || (para.vel.array() <= 0).any())
+		{
+			return -1;
+		}
+		return 0;
+	}
+
+	/**
+	 * @brief 推进单轴一个周期
+	 * @details 朝target以不超过vmax的速度运动，加速不超过amax、减速不超过dmax，并保证能以dmax在target处停下；
+	 * stop为true时只以dmax减速到零
+	 *
+	 * @param[in,out] pos 设定位置(单位:count)
+	 * @param[in,out] vel 设定速度(单位:count/s)
+	 * @param[in] target 目标点(单位:count)
+	 * @param[in] vmax 最大速度(单位:count/s)
+	 * @param[in] amax 最大加速度(单位:count/s^2)
+	 * @param[in] dmax 最大减速度(单位:count/s^2)
+	 * @param[in] dt 周期(单位:s)
+	 * @param[in] stop 是否减速停止
+	 * @return 是否已停在目标点(stop为true时为是否已停止)
+	 */
+	static bool Step(double &pos,double &vel,const double target,const double vmax,const double amax,const double dmax,const double dt,const bool stop=false)
+	{
+		const double error = target - pos;
+		double desired = 0.0;
+
+		if (!stop && fabs(error) <= dmax * dt * dt && fabs(vel) <= dmax * dt)
+		{
+			pos = target;
+			vel = 0.0;
+			return true;
+		}
+
+		if (!stop)
+		{
+			/* 离散时间下以dmax逐周期减速恰好停在target的速度 */
+			double brake = sqrt(dmax * dmax * dt * dt / 4 + 2 * dmax * fabs(error)) - dmax * dt / 2;
+			desired = copysign(std::min(brake,vmax),error);
+		}
+
+		double dv = desired - vel;
+		const bool speed_up = vel * (vel + dv) >= 0 && fabs(vel + dv) > fabs(vel);
+		const double limit = (speed_up ? amax : dmax) * dt;
+		dv = std::max(-limit,std::min(limit,dv));
+		vel += dv;
+
+		if (stop)
+		{
+			pos += vel * dt;
+			return vel == 0.0;
+		}
+
+		pos += vel * dt;
+		return false;
+	}
+
+	/**
+	 * @brief 从pos出发启动运动，通常通过MoveToAsync构造
+	 *
+	 * @param[in] group 轴组对象，须在运动结束前有效
+	 * @param[in] pos 起点，即轴组当前位置(单位:count)
+	 * @param[in] target 目标点(单位:count)
+	 * @param[in] para 加减速参数
+	 * @param[in] period 设定值下发周期(单位:us)
+	 */
+	MotionHandle(AiosGroup *group,const Eigen::VectorXd pos,const Eigen::VectorXd target,const ProfileParameters para,const unsigned int period)
+		: group_(group),period_(period * 1e-6),target_(target),para_(para),stop_(false),finished_(false),result_(-1)
+	{
+		thread_ = std::thread(&MotionHandle::Run,this,pos);
+	}
+
+	/**
+	 * @brief 析构时以最大减速度停止运动并等待后台线程结束
+	 * @attention 句柄释放即停止运动，需要运动继续时应保留句柄直到IsFinished为true或Wait返回
+	 */
+	~MotionHandle()
+	{
+		Stop();
+		Wait();
+	}
+
+	/**
+	 * @brief 修改运动目标点
+	 * @details 在下一个周期以当前的设定位置和速度为初始状态朝新目标点运动，运动过程不停止
+	 *
+	 * @param[in] pos 新目标点 单位（count）
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败，运动已结束或维数与轴组不一致
+	 */
+	int Retarget(const Eigen::VectorXd pos)
+	{
+		std::lock_guard <std::mutex> lock(mutex_);
+		if (finished_ || stop_ || pos.size() != target_.size())
+		{
+			return -1;
+		}
+		target_ = pos;
+		return 0;
+	}
+
+	/**
+	 * @brief 修改运动目标点及加减速参数
+	 * @details 同Retarget(pos)，新的加减速参数从下一个周期开始生效
+	 *
+	 * @param[in] pos 新目标点 单位（count）
+	 * @param[in] para 加减速参数
+	 * @return 执行成功与否
+	 *	 @retval 0 成功
+	 *	 @retval -1 失败，运动已结束、维数与轴组不一致或参数不为正
+	 */
+	int Retarget(const Eigen::VectorXd pos,const ProfileParameters para)
+	{
+		std::lock_guard <std::mutex> lock(mutex_);
+		if (finished_ || stop_ || pos.size() != target_.size() || CheckParameters(para,target_.size()) == -1)
+		{
+			return -1;
+		}
+		target_ = pos;
+		para_ = para;
+		return 0;
+	}
+
+	/**
+	 * @brief 读取运动是否结束
+	 *
+	 * @return 是否结束
+	 *	 @retval true 已到达目标点、被停止或出错
+	 *	 @retval false 运动中
+	 */
+	bool IsFinished()
+	{
+		return finished_;
+	}
+
+	/**
+	 * @brief 等待运动结束
+	 *
+	 * @return 运动结果
+	 *	 @retval 0 成功，已到达目标点
+	 *	 @retval -1 失败，被停止或通信失败
+	 */
+	int Wait()
+	{
+		if (thread_.joinable())
+		{
+			thread_.join();
+		}
+		return result_;
+	}
+
+	/**
+	 * @brief 以最大减速度停止本次运动，不影响其他运动
+	 *
+	 */
+	void Stop()
+	{
+		stop_ = true;
+	}
+};
+
+/**
+ * @brief 使轴组运行到目标点，立即返回运动句柄
+ * @details 从轴组当前位置出发，运动在后台线程中执行，可通过句柄的Retarget函数在运动中修改目标点而无需停止，
+ * 也可通过句柄的Stop函数或Motion::SetStopSignal()停止运行。与Motion::MoveTo相同，启动前清除停止信号。
+ * 释放句柄会停止运动，见~MotionHandle。
+ * Motion的静态成员只能由库定义，因此以自由函数提供而非Motion::MoveToAsync
+ *
+ * @param[in] group 轴组对象
+ * @param[in] pos 目标点 单位（count）
+ * @param[in] para 加减速参数(单位:count/s^2、count/s)
+ * @param[in] period 设定值下发周期(单位:us)
+ * @return 运动句柄
+ *	 @retval NULL 失败
+ *	 @retval 非NUll 成功
+ */
+inline std::shared_ptr <MotionHandle> MoveToAsync(AiosGroup *group,const Eigen::VectorXd pos,const ProfileParameters para,const unsigned int period=2000)
+{
+	Eigen::VectorXd start;
+
+	if (group == NULL || period == 0 || pos.size() != group->Size() || MotionHandle::CheckParameters(para,pos.size()) == -1 ||
+		group->GetPosition(start) == -1)
+	{
+		return nullptr;
+	}
+
+	Motion::InitStopSignal();
+	return std::make_shared <MotionHandle> (group,start,pos,para,period);
+}
+
+/**
+ * @brief 使轴组运行到目标点，立即返回运动句柄
+ * @details 同MoveToAsync(group,pos,para,period)，加减速参数取自轴组的位置梯形加减速参数(GetPositionProfileParameters)
+ *
+ * @param[in] group 轴组对象
+ * @param[in] pos 目标点 单位（count）
+ * @param[in] period 设定值下发周期(单位:us)
+ * @return 运动句柄
+ *	 @retval NULL 失败
+ *	 @retval 非NUll 成功
+ */
+inline std::shared_ptr <MotionHandle> MoveToAsync(AiosGroup *group,const Eigen::VectorXd pos,const unsigned int period=2000)
+{
+	ProfileParameters para;
+
+	if (group == NULL || group->GetPositionProfileParameters(para) == -1)
+	{
+		return nullptr;
+	}
+
+	return MoveToAsync(group,pos,para,period);
+}
+
+}
+
+#endif
@@ -0,0 +1,166 @@
+#ifndef PERIOD_CALIBRATION_H
+#define PERIOD_CALIBRATION_H
+
+#include <math.h>
+#include <algorithm>
+
+#include "drive_api.h"
+
+namespace Amber{
+
+class PeriodCalibration
+{
+public:
+	unsigned int samples;/**< 测量的往返次数 */
+	double loss;/**< 丢包率(0~1)，GetCvp失败的比例 */
+	double rtt_p50;/**< 往返时间中位数(单位:us) */
+	double rtt_p99;/**< 往返时间99分位(单位:us) */
+	double rtt_max;/**< 最大往返时间(单位:us) */
+	int period;/**< 推荐周期(单位:us)，往返时间超过该周期与丢包的总比例不超过miss_budget */
+};
+
+/**
+ * @brief 测量轴组的通信往返时间与丢包率，给出最短的稳定通信周期
+ * @details 对轴组连续执行samples次GetCvp并记录每次的往返时间，失败的往返计为丢包；
+ * 推荐周期为使往返时间超过周期的比例与丢包率之和不超过miss_budget的最短周期，向上取整到10us。
+ * 结果只作为建议，由调用方按推荐周期运行控制循环
+ *
+ * @param[in] group 轴组对象
+ * @param[out] result 测量结果与推荐周期
+ * @param[in] miss_budget 允许的超时比例
+ * @param[in] samples 测量的往返次数
+ * @return 执行成功与否
+ *	 @retval 0 成功
+ *	 @retval -1 失败，参数不合法或丢包率已超过miss_budget
+ */
+inline int CalibratePeriod(AiosGroup *group,PeriodCalibration &result,const double miss_budget=0.001,const unsigned int samples=1000)
+{
+	if (group == NULL || samples == 0 || miss_budget < 0.0 || miss_budget >= 1.0)
+	{
+		return -1;
+	}
+
+	vector <double> rtt;
+	CvpData fb;
+	double stamp;
+	rtt.reserve(samples);
+
+	for (unsigned int i=0; i<samples; i++)
+	{
+		const double start = GetMonotonicTime();
+		if (group->GetCvp(fb,stamp) == 0)
+		{
+			rtt.push_back((stamp - start) * 1e6);
+		}
+	}
+
+	std::sort(rtt.begin(),rtt.end());
+
+	const unsigned int lost = samples - rtt.size();
+	result.samples = samples;
+	result.loss = (double)lost / samples;
+	result.rtt_p50 = rtt.empty() ? 0.0 : rtt[std::min(rtt.size() - 1,(size_t)(0.5 * rtt.size()))];
+	result.rtt_p99 = rtt.empty() ? 0.0 : rtt[std::min(rtt.size() - 1,(size_t)(0.99 * rtt.size()))];
+	result.rtt_max = rtt.empty() ? 0.0 : rtt.back();
+	result.period = 0;
+
+	/* 允许超过周期的往返次数为预算减去丢包数 */
+	const long allowed = (long)floor(miss_budget * samples + 1e-9) - lost;
+	if (rtt.empty() || allowed < 0)
+	{
+		return -1;
+	}
+
+	const double bound = rtt[rtt.size() - 1 - std::min((size_t)allowed,rtt.size() - 1)];
+	result.period = (int)ceil(bound / 10.0) * 10;
+	return 0;
+}
+
+/**
+ * @brief 通信周期监测
+ * @details 控制循环每个周期调用一次Update并按返回的周期运行：一个统计窗口内超时与丢包的比例超过miss_budget时周期增大25%，
+ * 窗口内比例不超过miss_budget的一半时周期减小10%，逐步回到基准周期(通常为CalibratePeriod的推荐周期)。
+ * 不访问网络，超时的判定由调用方给出
+ */
+class PeriodMonitor
+{
+private:
+	int base_;
+	int max_period_;
+	int period_;
+	double miss_budget_;
+	unsigned int window_;
+	unsigned int cycles_;
+	unsigned int misses_;
+
+public:
+
+	/**
+	 * @brief 构造通信周期监测
+	 *
+	 * @param[in] base 基准周期(单位:us)
+	 * @param[in] miss_budget 允许的超时比例
+	 * @param[in] window 统计窗口的周期数
+	 * @param[in] max_period 周期上限(单位:us)，0表示基准周期的8倍
+	 */
+	PeriodMonitor(const int base,const double miss_budget=0.001,const unsigned int window=1000,const int max_period=0)
+		: base_(base),max_period_(max_period > 0 ? max_period : base * 8),period_(base),miss_budget_(miss_budget),
+		window_(window > 0 ? window : 1),cycles_(0),misses_(0)
+	{
+	}
+
+	/**
+	 * @brief 记录一个周期的结果
+	 *
+	 * @param[in] miss 本周期是否超时或通信失败
+	 * @return 之后应使用的周期(单位:us)
+	 */
+	int Update(const bool miss)
+	{
+		cycles_++;
+		misses_ += miss;
+
+		/* 窗口未满但超时数已超过预算时立即增大周期 */
+		if (misses_ > miss_budget_ * window_)
+		{
+			period_ = std::min(max_period_,period_ + std::max(1,period_ / 4));
+			cycles_ = 0;
+			misses_ = 0;
+		}
+		else if (cycles_ >= window_)
+		{
+			if (misses_ <= miss_budget_ * window_ / 2 && period_ > base_)
+			{
+				period_ = std::max(base_,period_ - std::max(1,period_ / 10));
+			}
+			cycles_ = 0;
+			misses_ = 0;
+		}
+
+		return period_;
+	}
+
+	/**
+	 * @brief 获取当前周期
+	 *
+	 * @return 当前周期(单位:us)
+	 */
+	int GetPeriod() const
+	{
+		return period_;
+	}
+
+	/**
+	 * @brief 获取基准周期
+	 *
+	 * @return 基准周期(单位:us)
+	 */
+	int GetBase() const
+	{
+		return base_;
+	}
+};
+
+}
+
+#endif
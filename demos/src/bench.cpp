@@ -0,0 +1,298 @@
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <dlfcn.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <jsoncpp/json/json.h>
+
+#include "drive_api.h"
+#include "cvp_parser.h"
+#include "responder.h"
+
+using namespace std;
+
+/* 仅统计测量线程内的内存分配和系统调用，应答线程与库内部线程不计入 */
+static thread_local bool g_counting = false;
+static thread_local unsigned long g_allocs = 0;
+static thread_local unsigned long g_syscalls = 0;
+
+/* 替换C库的分配函数，operator new、strdup及库内部的分配都经过这里，转交glibc的实现 */
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t count,size_t size);
+extern "C" void *__libc_realloc(void *p,size_t size);
+
+void *malloc(size_t size) noexcept
+{
+	g_allocs += g_counting;
+	return __libc_malloc(size);
+}
+
+void *calloc(size_t count,size_t size) noexcept
+{
+	g_allocs += g_counting;
+	return __libc_calloc(count,size);
+}
+
+void *realloc(void *p,size_t size) noexcept
+{
+	g_allocs += g_counting;
+	return __libc_realloc(p,size);
+}
+
+#define REAL(name) ((decltype(&name))dlsym(RTLD_NEXT,#name))
+
+ssize_t sendto(int fd,const void *buf,size_t len,int flags,const struct sockaddr *addr,socklen_t addr_len)
+{
+	static decltype(&sendto) real = REAL(sendto);
+	g_syscalls += g_counting;
+	return real(fd,buf,len,flags,addr,addr_len);
+}
+
+ssize_t recvfrom(int fd,void *buf,size_t len,int flags,struct sockaddr *addr,socklen_t *addr_len)
+{
+	static decltype(&recvfrom) real = REAL(recvfrom);
+	g_syscalls += g_counting;
+	return real(fd,buf,len,flags,addr,addr_len);
+}
+
+ssize_t sendmsg(int fd,const struct msghdr *msg,int flags)
+{
+	static decltype(&sendmsg) real = REAL(sendmsg);
+	g_syscalls += g_counting;
+	return real(fd,msg,flags);
+}
+
+ssize_t recvmsg(int fd,struct msghdr *msg,int flags)
+{
+	static decltype(&recvmsg) real = REAL(recvmsg);
+	g_syscalls += g_counting;
+	return real(fd,msg,flags);
+}
+
+int poll(struct pollfd *fds,nfds_t nfds,int timeout)
+{
+	static decltype(&poll) real = REAL(poll);
+	g_syscalls += g_counting;
+	return real(fds,nfds,timeout);
+}
+
+int select(int nfds,fd_set *readfds,fd_set *writefds,fd_set *exceptfds,struct timeval *timeout)
+{
+	static decltype(&select) real = REAL(select);
+	g_syscalls += g_counting;
+	return real(nfds,readfds,writefds,exceptfds,timeout);
+}
+
+/**
+ * @brief 运行一项测量并以一行JSON输出结果
+ * @return 执行成功与否
+ *	 @retval 0 成功 
+ *	 @retval -1 被测函数返回失败
+ */
+static int Measure(const string name,int axes,unsigned int iterations,std::function<int()> op)
+{
+	for (unsigned int i=0; i<iterations/10 + 1; i++)
+	{
+		if (op() == -1)
+		{
+			return -1;
+		}
+	}
+
+	g_allocs = 0;
+	g_syscalls = 0;
+	g_counting = true;
+	auto start = std::chrono::steady_clock::now();
+
+	for (unsigned int i=0; i<iterations; i++)
+	{
+		if (op() == -1)
+		{
+			g_counting = false;
+			return -1;
+		}
+	}
+
+	auto stop = std::chrono::steady_clock::now();
+	g_counting = false;
+
+	double ns = std::chrono::duration<double,std::nano>(stop - start).count();
+
+	Json::Value result;
+	result["name"] = name;
+	result["axes"] = axes;
+	result["iterations"] = iterations;
+	result["ns_per_op"] = ns / iterations;
+	result["allocs_per_op"] = (double)g_allocs / iterations;
+	result["syscalls_per_op"] = (double)g_syscalls / iterations;
+
+	Json::FastWriter writer;
+	cout << writer.write(result);
+	return 0;
+}
+
+static int BenchJson(int axes,unsigned int iterations)
+{
+	Json::Value request;
+	request["method"] = "SET";
+	request["reqTarget"] = "/m1/setPosition";
+	request["property"] = "";
+	request["position"] = 12345.678;
+	request["velocity_ff"] = 0.0;
+	request["current_ff"] = 0.0;
+
+	Json::FastWriter writer;
+	Measure("json_encode",axes,iterations,[&]()
+	{
+		for (int i=0; i<axes; i++)
+		{
+			request["position"] = 12345.678 + i;
+			std::string data = writer.write(request);
+		}
+		return 0;
+	});
+
+	const std::string reply = "{\"current\":0.123,\"position\":12345.678,\"reqTarget\":\"/m1/CVP\",\"status\":\"OK\",\"velocity\":-3.25}\n";
+	Json::Reader reader;
+	Amber::CvpData fb;
+	fb.pos.resize(axes);
+	fb.vel.resize(axes);
+	fb.current.resize(axes);
+
+	if (Measure("json_decode",axes,iterations,[&]()
+	{
+		for (int i=0; i<axes; i++)
+		{
+			Json::Value root;
+			if (!reader.parse(reply,root))
+			{
+				return -1;
+			}
+			fb.pos(i) = root["position"].asDouble();
+			fb.vel(i) = root["velocity"].asDouble();
+			fb.current(i) = root["current"].asDouble();
+		}
+		return 0;
+	}) == -1)
+	{
+		return -1;
+	}
+
+	return Measure("cvp_parse",axes,iterations,[&]()
+	{
+		for (int i=0; i<axes; i++)
+		{
+			if (Amber::ParseCvpReply(reply.c_str(),reply.size(),fb,i) == -1)
+			{
+				return -1;
+			}
+		}
+		return 0;
+	});
+}
+
+static int BenchGroup(std::shared_ptr <Amber::AiosGroup> group_ptr,unsigned int iterations)
+{
+	if (!group_ptr)
+	{
+		cerr << "INFO: loopback discovery failed, 10.0.0.255 must be reachable locally (sudo ip addr add 10.0.0.1/24 dev lo)" << endl;
+		return -1;
+	}
+
+	Amber::AiosGroup &group = *group_ptr;
+	int axes = group.Size();
+
+	Amber::CvpData fb;
+	Eigen::VectorXd pos = Eigen::VectorXd::Zero(axes);
+
+	if (Measure("get_cvp",axes,iterations,[&](){ return group.GetCvp(fb); }) == -1 ||
+		Measure("set_position",axes,iterations,[&](){ return group.SetPosition(pos,fb); }) == -1)
+	{
+		cerr << "INFO: " << Amber::GetSystemError() << endl;
+		return -1;
+	}
+
+	return 0;
+}
+
+static int BenchLoopback(int axes,unsigned int iterations)
+{
+	LoopbackResponder responder(axes);
+	if (responder.Start() == -1)
+	{
+		cerr << "INFO: failed to bind loopback responder" << endl;
+		return -1;
+	}
+
+	return BenchGroup(responder.Connect(),iterations);
+}
+
+static int BenchReplay(const std::string file_path,unsigned int iterations)
+{
+	ReplayResponder responder;
+	if (responder.Load(file_path) == -1 || responder.Start() == -1)
+	{
+		cerr << "INFO: failed to replay " << file_path << endl;
+		return -1;
+	}
+
+	return BenchGroup(ConnectLoopback(responder.Size()),iterations);
+}
+
+int main(int argc, char *argv[])  
+{
+	unsigned int iterations = 10000;
+	std::vector <int> axes_list = {1,2,4,8,16};
+	std::string replay_file;
+
+	for (int i=1; i<argc; i++)
+	{
+		if (!strcmp(argv[i],"--iterations") && i + 1 < argc)
+		{
+			iterations = atoi(argv[++i]);
+		}
+		else if (!strcmp(argv[i],"--axes") && i + 1 < argc)
+		{
+			axes_list.clear();
+			std::stringstream ss(argv[++i]);
+			std::string item;
+			while (std::getline(ss,item,','))
+			{
+				axes_list.push_back(atoi(item.c_str()));
+			}
+		}
+		else if (!strcmp(argv[i],"--replay") && i + 1 < argc)
+		{
+			replay_file = argv[++i];
+		}
+		else
+		{
+			cerr << "usage: " << argv[0] << " [--iterations N] [--axes 1,2,4,...] [--replay traffic.cap]" << endl;
+			return -1;
+		}
+	}
+
+	if (!replay_file.empty())
+	{
+		return BenchReplay(replay_file,iterations / 10 + 1);
+	}
+
+	for (auto axes : axes_list)
+	{
+		if (BenchJson(axes,iterations) == -1 || BenchLoopback(axes,iterations / 10 + 1) == -1)
+		{
+			return -1;
+		}
+	}
+
+	return 0;
+}
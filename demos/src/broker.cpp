@@ -0,0 +1,62 @@
+#include <string.h>
+#include <iostream>
+#include <fstream>
+#include <jsoncpp/json/json.h>
+
+#include "broker_api.h"
+
+using namespace std;
+
+int main(int argc, char *argv[])  
+{	  
+	Amber::Lookup lookup;
+	Amber::Broker broker;
+
+	std::vector < string > serial_number;
+	
+	Json::Reader reader;
+	Json::Value root;
+	 
+	ifstream in("config.json", ios::binary);
+	 
+	if (!in.is_open())
+	{
+		return 0;
+	}
+	 
+	if (reader.parse(in, root))
+	{
+		for (int i=0;i<root.size();i++)
+		{
+			serial_number.push_back(root[i]["serial_number"].asString());
+		}
+	}
+	else
+	{
+		return 0;
+	}
+
+	std::shared_ptr <Amber::AiosGroup> group = lookup.GetHandlesFromSerialNumberList(serial_number);
+	if (!group)
+	{
+		cout << "\033[31m" << "INFO: No device found on network" << endl;
+		return -1;
+	}
+
+	cout << "\033[32m" << "INFO: "<< group->Size() << " devices found on network" << endl;
+
+	if (broker.AddGroup("group0",group) == -1 || broker.Start() == -1)
+	{
+		cout << "\033[31m" << "INFO: Failed to start broker, is another broker serving group0?" << endl;
+		return -1;
+	}
+
+	cout << "\033[33m" << "INFO: Serving group0, press enter to exit." << endl;
+
+	while (getchar() != '\n')
+	{
+	}
+
+	broker.Stop();
+	return 0;
+}
@@ -0,0 +1,120 @@
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <dlfcn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <mutex>
+#include <string>
+
+/*
+ * 通信报文录制库，通过LD_PRELOAD加载到使用libaiosapi的程序中：
+ *
+ *   LD_PRELOAD=./bin/libaioscapture.so AIOS_CAPTURE=traffic.cap ./bin/teach
+ *
+ * 截获进程内与执行器端口(2333、2334)之间的sendto和recvfrom，每帧一行JSON：
+ * {"t":时间戳(单位:s，CLOCK_MONOTONIC时基),"dir":"tx"或"rx","ip":执行器ip地址,"port":端口,"data":报文内容}，
+ * 录制文件可由bench --replay在本机回放。AIOS_CAPTURE未设置时写入traffic.cap
+ */
+
+#define REAL(name) ((decltype(&name))dlsym(RTLD_NEXT,#name))
+
+static std::mutex g_mutex;
+static FILE *g_file = NULL;
+
+static FILE *CaptureFile()
+{
+	if (!g_file)
+	{
+		const char *path = getenv("AIOS_CAPTURE");
+		g_file = fopen(path ? path : "traffic.cap","w");
+	}
+	return g_file;
+}
+
+static void Record(const char *dir,const struct sockaddr *addr,const void *buf,size_t len)
+{
+	if (addr == NULL || addr->sa_family != AF_INET)
+	{
+		return;
+	}
+
+	const struct sockaddr_in *in = (const struct sockaddr_in *)addr;
+	int port = ntohs(in->sin_port);
+	if (port != 2333 && port != 2334)
+	{
+		return;
+	}
+
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+
+	char ip[INET_ADDRSTRLEN];
+	inet_ntop(AF_INET,&in->sin_addr,ip,sizeof(ip));
+
+	/* 请求以'\0'补齐到固定长度，只保留有效内容 */
+	const char *data = (const char *)buf;
+	std::string line;
+	char head[128];
+	snprintf(head,sizeof(head),"{\"t\":%.9f,\"dir\":\"%s\",\"ip\":\"%s\",\"port\":%d,\"data\":\"",ts.tv_sec + ts.tv_nsec * 1e-9,dir,ip,port);
+	line = head;
+
+	for (size_t i=0; i<len && data[i] != '\0'; i++)
+	{
+		unsigned char c = data[i];
+		if (c == '"' || c == '\\')
+		{
+			line += '\\';
+			line += c;
+		}
+		else if (c < 0x20)
+		{
+			char escape[8];
+			snprintf(escape,sizeof(escape),"\\u%04x",c);
+			line += escape;
+		}
+		else
+		{
+			line += c;
+		}
+	}
+	line += "\"}\n";
+
+	std::lock_guard <std::mutex> lock(g_mutex);
+	FILE *file = CaptureFile();
+	if (file)
+	{
+		fwrite(line.c_str(),1,line.size(),file);
+		fflush(file);
+	}
+}
+
+extern "C" ssize_t sendto(int fd,const void *buf,size_t len,int flags,const struct sockaddr *addr,socklen_t addr_len)
+{
+	static decltype(&sendto) real = REAL(sendto);
+	ssize_t ret = real(fd,buf,len,flags,addr,addr_len);
+
+	if (ret > 0)
+	{
+		Record("tx",addr,buf,ret);
+	}
+	return ret;
+}
+
+extern "C" ssize_t recvfrom(int fd,void *buf,size_t len,int flags,struct sockaddr *addr,socklen_t *addr_len)
+{
+	static decltype(&recvfrom) real = REAL(recvfrom);
+	ssize_t ret = real(fd,buf,len,flags,addr,addr_len);
+
+	if (ret > 0)
+	{
+		Record("rx",addr,buf,ret);
+	}
+	return ret;
+}
@@ -26,13 +26,14 @@ static void PressEnterToExit()
 void WorkThread(Amber::AiosGroup *group)
 {	
 	Amber::CvpData fb;
+	double stamp = 0,last_stamp = 0;
 	Amber::Motion::InitStopSignal();
 
 	cout << "\033[33m" << "Start" << endl;
 
 	while ( !Amber::Motion::GetStopSignal() )
 	{	
-		if (group->GetCvp(fb) == -1)
+		if (group->GetCvp(fb,stamp) == -1)
 		{
 			return;
 		}
@@ -44,6 +45,12 @@ void WorkThread(Amber::AiosGroup *group)
 			printf("%.1f ",fb.pos(i));
 		}
 
+		if (last_stamp > 0)
+		{
+			printf(" period : %.1fus ",(stamp - last_stamp) * 1e6);
+		}
+		last_stamp = stamp;
+
 		fflush(stdout);
 	}
 }
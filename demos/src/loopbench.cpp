@@ -0,0 +1,322 @@
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/resource.h>
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <jsoncpp/json/json.h>
+
+#include "drive_api.h"
+#include "period_calibration.h"
+#include "responder.h"
+
+using namespace std;
+
+static double Seconds(const struct timespec &ts)
+{
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void Advance(struct timespec &ts,int period)
+{
+	ts.tv_nsec += period * 1000L;
+	while (ts.tv_nsec >= 1000000000L)
+	{
+		ts.tv_nsec -= 1000000000L;
+		ts.tv_sec++;
+	}
+}
+
+/* 只统计调用线程，不含回环应答线程与库内部线程 */
+static double CpuTime()
+{
+	struct rusage usage;
+	getrusage(RUSAGE_THREAD,&usage);
+	return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec * 1e-6 + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec * 1e-6;
+}
+
+static std::vector <int> ParseList(const char *text)
+{
+	std::vector <int> list;
+	std::stringstream ss(text);
+	std::string item;
+
+	while (std::getline(ss,item,','))
+	{
+		list.push_back(atoi(item.c_str()));
+	}
+
+	return list;
+}
+
+static double Percentile(const std::vector <double> &sorted,double p)
+{
+	if (sorted.empty())
+	{
+		return 0.0;
+	}
+
+	return sorted[std::min(sorted.size() - 1,(size_t)(p * sorted.size()))];
+}
+
+/**
+ * @brief 以period为周期对index内的执行器运行duration秒的位置保持闭环(发送设定值并读取反馈)，输出一行JSON结果
+ * @details 周期耗时为一次SetPosition的时长，唤醒间隔为相邻两次唤醒的时间差，抖动为唤醒间隔与period之差的绝对值；
+ * 超时的周期计入deadline_miss，并跳过已错过的整周期，使之后的唤醒仍落在周期网格上；
+ * index覆盖整个轴组时使用整组的SetPosition，cpu_percent只统计本线程
+ * @return 执行成功与否
+ *	 @retval 0 成功 
+ *	 @retval -1 通信失败
+ */
+static int RunLoop(Amber::AiosGroup *group,const std::vector <int> index,int period,double duration,bool adaptive)
+{
+	const bool whole = (int)index.size() == group->Size();
+	Amber::CvpData fb;
+	if ((whole ? group->GetCvp(fb) : group->GetCvp(index,fb)) == -1)
+	{
+		return -1;
+	}
+
+	Eigen::VectorXd hold = fb.pos;
+	std::vector <double> cycle;
+	std::vector <double> wake;
+	std::vector <double> jitter;
+	unsigned int miss = 0;
+	unsigned int skipped = 0;
+	unsigned int error = 0;
+	double last_wake = 0.0;
+	Amber::PeriodMonitor monitor(period);
+
+	cycle.reserve(duration * 1e6 / period + 1);
+	wake.reserve(duration * 1e6 / period + 1);
+	jitter.reserve(duration * 1e6 / period + 1);
+
+	struct timespec deadline;
+	clock_gettime(CLOCK_MONOTONIC,&deadline);
+
+	double start = Amber::GetMonotonicTime();
+	double cpu_start = CpuTime();
+
+	while (Amber::GetMonotonicTime() - start < duration)
+	{
+		double cycle_start = Amber::GetMonotonicTime();
+
+		if (last_wake > 0.0)
+		{
+			wake.push_back(cycle_start - last_wake);
+			jitter.push_back(fabs(cycle_start - last_wake - period * 1e-6));
+		}
+		last_wake = cycle_start;
+
+		bool failed = (whole ? group->SetPosition(hold,fb) : group->SetPosition(index,hold,fb)) == -1;
+		if (failed)
+		{
+			error++;
+		}
+
+		double cycle_end = Amber::GetMonotonicTime();
+		cycle.push_back(cycle_end - cycle_start);
+
+		Advance(deadline,period);
+
+		bool missed = cycle_end > Seconds(deadline);
+		if (missed)
+		{
+			miss++;
+			while (cycle_end > Seconds(deadline))
+			{
+				Advance(deadline,period);
+				skipped++;
+			}
+		}
+
+		if (adaptive)
+		{
+			period = monitor.Update(missed || failed);
+		}
+
+		clock_nanosleep(CLOCK_MONOTONIC,TIMER_ABSTIME,&deadline,NULL);
+	}
+
+	double elapsed = Amber::GetMonotonicTime() - start;
+	double cpu = CpuTime() - cpu_start;
+
+	std::sort(cycle.begin(),cycle.end());
+	std::sort(wake.begin(),wake.end());
+	std::sort(jitter.begin(),jitter.end());
+
+	Json::Value result;
+	result["axes"] = (int)index.size();
+	result["period_us"] = monitor.GetBase();
+	result["final_period_us"] = period;
+	result["cycles"] = (unsigned int)cycle.size();
+	result["rate_hz"] = cycle.size() / elapsed;
+	result["cycle_p50_us"] = Percentile(cycle,0.5) * 1e6;
+	result["cycle_p90_us"] = Percentile(cycle,0.9) * 1e6;
+	result["cycle_p99_us"] = Percentile(cycle,0.99) * 1e6;
+	result["cycle_p999_us"] = Percentile(cycle,0.999) * 1e6;
+	result["cycle_max_us"] = cycle.empty() ? 0.0 : cycle.back() * 1e6;
+	result["wake_p50_us"] = Percentile(wake,0.5) * 1e6;
+	result["wake_p99_us"] = Percentile(wake,0.99) * 1e6;
+	result["wake_max_us"] = wake.empty() ? 0.0 : wake.back() * 1e6;
+	result["jitter_p50_us"] = Percentile(jitter,0.5) * 1e6;
+	result["jitter_p99_us"] = Percentile(jitter,0.99) * 1e6;
+	result["jitter_max_us"] = jitter.empty() ? 0.0 : jitter.back() * 1e6;
+	result["deadline_miss"] = miss;
+	result["skipped_periods"] = skipped;
+	result["errors"] = error;
+	result["cpu_percent"] = cpu / elapsed * 100.0;
+
+	Json::FastWriter writer;
+	cout << writer.write(result);
+	return 0;
+}
+
+int main(int argc, char *argv[])  
+{	  
+	std::vector <int> periods = {4000,2000,1000,500};
+	std::vector <int> axes_list;
+	double duration = 2.0;
+	int loopback = 0;
+	bool calibrate = false;
+	bool adaptive = false;
+
+	for (int i=1; i<argc; i++)
+	{
+		if (!strcmp(argv[i],"--periods") && i + 1 < argc)
+		{
+			periods = ParseList(argv[++i]);
+		}
+		else if (!strcmp(argv[i],"--axes") && i + 1 < argc)
+		{
+			axes_list = ParseList(argv[++i]);
+		}
+		else if (!strcmp(argv[i],"--duration") && i + 1 < argc)
+		{
+			duration = atof(argv[++i]);
+		}
+		else if (!strcmp(argv[i],"--loopback") && i + 1 < argc)
+		{
+			loopback = atoi(argv[++i]);
+		}
+		else if (!strcmp(argv[i],"--calibrate"))
+		{
+			calibrate = true;
+		}
+		else if (!strcmp(argv[i],"--adaptive"))
+		{
+			adaptive = true;
+		}
+		else
+		{
+			cerr << "usage: " << argv[0] << " [--periods 4000,2000,...(us)] [--axes 1,2,...] [--duration s] [--loopback N] [--calibrate] [--adaptive]" << endl;
+			return -1;
+		}
+	}
+
+	if (periods.empty() || *std::min_element(periods.begin(),periods.end()) <= 0 ||
+		(!axes_list.empty() && *std::min_element(axes_list.begin(),axes_list.end()) <= 0) || duration <= 0.0 || loopback < 0)
+	{
+		cerr << "\033[31m" << "INFO: periods, axes and duration must be positive" << endl;
+		return -1;
+	}
+
+	std::shared_ptr <Amber::AiosGroup> group;
+	std::shared_ptr <LoopbackResponder> responder;
+
+	if (loopback > 0)
+	{
+		responder = std::make_shared <LoopbackResponder> (loopback);
+		if (responder->Start() == -1)
+		{
+			cerr << "\033[31m" << "INFO: failed to bind loopback responder" << endl;
+			return -1;
+		}
+
+		group = responder->Connect();
+		if (!group)
+		{
+			cerr << "\033[31m" << "INFO: loopback discovery failed, 10.0.0.255 must be reachable locally (sudo ip addr add 10.0.0.1/24 dev lo)" << endl;
+			return -1;
+		}
+	}
+	else
+	{
+		Amber::Lookup lookup;
+
+		std::vector < string > serial_number;
+	
+		Json::Reader reader;
+		Json::Value root;
+	 
+		ifstream in("config.json", ios::binary);
+	 
+		if (!in.is_open())
+		{
+			return 0;
+		}
+	 
+		if (reader.parse(in, root))
+		{
+			for (int i=0;i<root.size();i++)
+			{
+				serial_number.push_back(root[i]["serial_number"].asString());
+			}
+		}
+		else
+		{
+			return 0;
+		}
+
+		group = lookup.GetHandlesFromSerialNumberList(serial_number);
+		if (!group)
+		{
+			cerr << "\033[31m" << "INFO: No device found on network" << endl;
+			return -1;
+		}
+	}
+
+	cerr << "\033[32m" << "INFO: "<< group->Size() << " devices" << "\033[0m" << endl;
+
+	if (calibrate)
+	{
+		Amber::PeriodCalibration calibration;
+		if (Amber::CalibratePeriod(group.get(),calibration) == -1)
+		{
+			cerr << "\033[31m" << "INFO: calibration failed, loss " << calibration.loss * 100 << "% exceeds the miss budget" << endl;
+			return -1;
+		}
+
+		cerr << "\033[32m" << "INFO: rtt p50 " << calibration.rtt_p50 << "us, p99 " << calibration.rtt_p99 << "us, loss " << calibration.loss * 100
+			<< "%, recommended period " << calibration.period << "us" << "\033[0m" << endl;
+		periods.insert(periods.begin(),calibration.period);
+	}
+
+	if (axes_list.empty())
+	{
+		axes_list.push_back(group->Size());
+	}
+
+	for (auto axes : axes_list)
+	{
+		std::vector <int> index;
+		for (int i=0; i<std::min(axes,group->Size()); i++)
+		{
+			index.push_back(i);
+		}
+
+		for (auto period : periods)
+		{
+			if (RunLoop(group.get(),index,period,duration,adaptive) == -1)
+			{
+				cerr << "\033[31m" << "INFO: " << Amber::GetSystemError() << endl;
+				return -1;
+			}
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,667 @@
+#ifndef RESPONDER_H
+#define RESPONDER_H
+
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <jsoncpp/json/json.h>
+
+#include "drive_api.h"
+
+/**
+ * @brief 127.0.0.(index+1) 即第index个模拟执行器的地址
+ */
+static inline std::string LoopbackAddress(int index)
+{
+	return "127.0.0." + std::to_string(index + 1);
+}
+
+/**
+ * @brief 在每个模拟执行器地址的port端口上绑定一个UDP套接字
+ * @return 执行成功与否
+ *	 @retval 0 成功 
+ *	 @retval -1 失败，已打开的套接字被关闭
+ */
+static inline int OpenLoopbackSockets(int axis_num,int port,std::vector <int> &sockets)
+{
+	int on = 1;
+
+	for (int i=0; i<axis_num; i++)
+	{
+		struct sockaddr_in addr;
+		memset(&addr,0,sizeof(addr));
+		addr.sin_family = AF_INET;
+		addr.sin_port = htons(port);
+		inet_pton(AF_INET,LoopbackAddress(i).c_str(),&addr.sin_addr);
+
+		int fd = socket(AF_INET,SOCK_DGRAM,0);
+		if (fd >= 0)
+		{
+			setsockopt(fd,SOL_SOCKET,SO_REUSEADDR,&on,sizeof(on));
+		}
+
+		if (fd < 0 || bind(fd,(struct sockaddr *)&addr,sizeof(addr)) < 0)
+		{
+			if (fd >= 0)
+			{
+				close(fd);
+			}
+
+			for (size_t j=0; j<sockets.size(); j++)
+			{
+				close(sockets[j]);
+			}
+			sockets.clear();
+			return -1;
+		}
+
+		sockets.push_back(fd);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief 第index个模拟执行器应答发现广播的内容
+ */
+static inline Json::Value LoopbackIdentity(int index)
+{
+	Json::Value identity;
+	identity["serial_number"] = "LOOPBACK" + std::to_string(index);
+	identity["mac_address"] = "00:00:00:00:00:" + std::to_string(10 + index);
+	identity["motor_drive_ready"] = true;
+	identity["Fw_version"] = "loopback";
+	identity["Hw_version"] = "loopback";
+	return identity;
+}
+
+/**
+ * @brief 在0.0.0.0:2334上绑定接收发现广播的UDP套接字
+ * @return 套接字
+ *	 @retval -1 失败
+ */
+static inline int OpenDiscoverySocket()
+{
+	int on = 1;
+	struct sockaddr_in addr;
+	memset(&addr,0,sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(2334);
+	addr.sin_addr.s_addr = htonl(INADDR_ANY);
+
+	int fd = socket(AF_INET,SOCK_DGRAM,0);
+	if (fd >= 0)
+	{
+		setsockopt(fd,SOL_SOCKET,SO_REUSEADDR,&on,sizeof(on));
+	}
+
+	if (fd < 0 || bind(fd,(struct sockaddr *)&addr,sizeof(addr)) < 0)
+	{
+		if (fd >= 0)
+		{
+			close(fd);
+		}
+		return -1;
+	}
+
+	return fd;
+}
+
+/**
+ * @brief 读取一帧发现广播，并从每个执行器的2334端口套接字回复其LoopbackIdentity，使Lookup得到127.0.0.x的地址
+ */
+static inline void AnswerDiscovery(int discovery,const std::vector <int> &sockets)
+{
+	char buffer[512];
+	struct sockaddr_in from;
+	socklen_t from_len = sizeof(from);
+
+	if (recvfrom(discovery,buffer,sizeof(buffer),0,(struct sockaddr *)&from,&from_len) <= 0)
+	{
+		return;
+	}
+
+	Json::FastWriter writer;
+	for (size_t i=0; i<sockets.size(); i++)
+	{
+		std::string data = writer.write(LoopbackIdentity(i));
+		sendto(sockets[i],data.c_str(),data.size(),0,(struct sockaddr *)&from,from_len);
+	}
+}
+
+/**
+ * @brief 通过Lookup按序列号连接axis_num个模拟执行器
+ * @details 库的发现广播固定发往10.0.0.255:2334，需要该地址在本机可达，例如 sudo ip addr add 10.0.0.1/24 dev lo
+ * @return 轴组对象
+ *	 @retval NULL 失败 
+ *	 @retval 非NUll 成功 
+ */
+static inline std::shared_ptr <Amber::AiosGroup> ConnectLoopback(int axis_num)
+{
+	Amber::Lookup lookup;
+	std::vector <std::string> serial_number;
+
+	for (int i=0; i<axis_num; i++)
+	{
+		serial_number.push_back(LoopbackIdentity(i)["serial_number"].asString());
+	}
+
+	std::shared_ptr <Amber::AiosGroup> group = lookup.GetHandlesFromSerialNumberList(serial_number);
+	if (group && group->Size() != axis_num)
+	{
+		group.reset();
+	}
+	return group;
+}
+
+/**
+ * @brief 本机执行器模拟器
+ * @details 在127.0.0.1~127.0.0.N的2333和2334端口上各绑定一个套接字，并在0.0.0.0:2334上应答发现广播；
+ * 收到请求后回复reqTarget及position、velocity、current和status字段，reply_enable为false的请求不回复，
+ * 控制器与电机配置的读取回复一组固定值。用于在没有实体执行器时测试通信与控制循环
+ */
+class LoopbackResponder
+{
+private:
+	int axis_num_;
+	int discovery_;
+	std::vector <int> sockets_;
+	std::atomic <bool> running_;
+	std::thread thread_;
+
+	void Run()
+	{
+		std::vector <struct pollfd> fds(sockets_.size() + 1);
+		std::vector <double> pos(axis_num_,0.0);
+		char buffer[2048];
+		Json::Reader reader;
+		Json::FastWriter writer;
+
+		for (size_t i=0; i<sockets_.size(); i++)
+		{
+			fds[i].fd = sockets_[i];
+			fds[i].events = POLLIN;
+		}
+		fds.back().fd = discovery_;
+		fds.back().events = POLLIN;
+
+		while (running_)
+		{
+			if (poll(fds.data(),fds.size(),10) <= 0)
+			{
+				continue;
+			}
+
+			if (fds.back().revents & POLLIN)
+			{
+				AnswerDiscovery(discovery_,std::vector <int> (sockets_.begin(),sockets_.begin() + axis_num_));
+			}
+
+			for (size_t k=0; k<sockets_.size(); k++)
+			{
+				if (!(fds[k].revents & POLLIN))
+				{
+					continue;
+				}
+
+				int i = k % axis_num_;
+				struct sockaddr_in from;
+				socklen_t from_len = sizeof(from);
+				ssize_t len = recvfrom(sockets_[k],buffer,sizeof(buffer),0,(struct sockaddr *)&from,&from_len);
+				if (len <= 0)
+				{
+					continue;
+				}
+
+				Json::Value request;
+				if (!reader.parse(buffer,buffer + strnlen(buffer,len),request) || !request.isObject())
+				{
+					continue;
+				}
+
+				if (request.isMember("position"))
+				{
+					pos[i] = request["position"].asDouble();
+				}
+
+				if (request.isMember("reply_enable") && !request["reply_enable"].asBool())
+				{
+					continue;
+				}
+
+				/* 库按256字节接收应答，回复只带必要的字段 */
+				Json::Value reply;
+				std::string target = request["reqTarget"].asString();
+				reply["reqTarget"] = target;
+
+				if (target.find("/controller/config") != std::string::npos)
+				{
+					reply["control_mode"] = Amber::kPositionMode;
+					reply["pos_gain"] = 20.0;
+					reply["vel_gain"] = 0.0005;
+					reply["vel_integrator_gain"] = 0.0002;
+					reply["vel_limit"] = 400000.0;
+				}
+				else if (target.find("/motor/config") != std::string::npos)
+				{
+					reply["current_lim"] = 10.0;
+					reply["current_control_bandwidth"] = 1000.0;
+				}
+				else
+				{
+					reply["position"] = pos[i];
+					reply["velocity"] = 0.0;
+					reply["current"] = 0.0;
+				}
+				reply["status"] = "OK";
+
+				std::string data = writer.write(reply);
+				sendto(sockets_[k],data.c_str(),data.size(),0,(struct sockaddr *)&from,from_len);
+			}
+		}
+	}
+
+public:
+	LoopbackResponder(int axis_num):axis_num_(axis_num),discovery_(-1),running_(false)
+	{
+	}
+
+	~LoopbackResponder()
+	{
+		Stop();
+	}
+
+	/**
+	 * @brief 打开套接字并启动应答线程
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败，执行器个数不为正或套接字打开失败
+	 */
+	int Start()
+	{
+		if (axis_num_ <= 0)
+		{
+			return -1;
+		}
+
+		if (OpenLoopbackSockets(axis_num_,2334,sockets_) == -1 || OpenLoopbackSockets(axis_num_,2333,sockets_) == -1 ||
+			(discovery_ = OpenDiscoverySocket()) == -1)
+		{
+			Stop();
+			return -1;
+		}
+
+		running_ = true;
+		thread_ = std::thread(&LoopbackResponder::Run,this);
+		return 0;
+	}
+
+	/**
+	 * @brief 通过Lookup连接本模拟器，见ConnectLoopback
+	 */
+	std::shared_ptr <Amber::AiosGroup> Connect() const
+	{
+		return ConnectLoopback(axis_num_);
+	}
+
+	void Stop()
+	{
+		running_ = false;
+
+		if (thread_.joinable())
+		{
+			thread_.join();
+		}
+
+		for (size_t i=0; i<sockets_.size(); i++)
+		{
+			close(sockets_[i]);
+		}
+		sockets_.clear();
+
+		if (discovery_ >= 0)
+		{
+			close(discovery_);
+			discovery_ = -1;
+		}
+	}
+};
+
+/**
+ * @brief 通信报文回放器
+ * @details 读取libaioscapture录制的文件，录制中第k个应答过的执行器对应本机127.0.0.(k+1)，并以LoopbackIdentity应答发现广播。
+ * 录制时每帧应答按reqTarget(不区分/m0、/m1)和端口匹配到该执行器上尚未应答的同一reqTarget的最早请求，
+ * 回放时按收到请求的端口、method和reqTarget取出该执行器录制中同类请求的下一次交互，循环使用，
+ * 在收到请求后按录制的应答延时发送录制的应答；录制中没有应答的请求、未录制过的请求及reply_enable为false的请求不回复。
+ * 延时逐帧相对各自的请求计算，各轴独立回放，不复现不同执行器之间应答的先后顺序
+ */
+class ReplayResponder
+{
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	class Exchange
+	{
+	public:
+		double t;
+		std::vector <std::pair <double,std::string> > replies;
+	};
+
+	class Sequence
+	{
+	public:
+		std::vector <Exchange> exchanges;
+		size_t cursor;
+
+		Sequence():cursor(0)
+		{
+		}
+	};
+
+	class Outstanding
+	{
+	public:
+		std::string target;
+		std::string key;
+		size_t index;
+	};
+
+	class Pending
+	{
+	public:
+		int socket;
+		struct sockaddr_in to;
+		std::string data;
+	};
+
+	std::vector <std::string> ip_list_;
+	std::vector <std::map <std::string,Sequence> > sequences_;
+	int discovery_;
+	std::vector <int> sockets_;
+	std::atomic <bool> running_;
+	std::thread thread_;
+
+	/* 去掉/m0、/m1前缀，回放时的电机编号可能与录制时不同 */
+	static std::string Target(const Json::Value &data)
+	{
+		std::string target = data["reqTarget"].asString();
+		if (target.compare(0,4,"/m0/") == 0 || target.compare(0,4,"/m1/") == 0)
+		{
+			target = target.substr(3);
+		}
+		return target;
+	}
+
+	static std::string Key(int port,const Json::Value &request)
+	{
+		return std::to_string(port) + " " + request["method"].asString() + " " + Target(request);
+	}
+
+	static bool ReplyEnabled(const Json::Value &request)
+	{
+		return !request.isMember("reply_enable") || request["reply_enable"].asBool();
+	}
+
+	void Run()
+	{
+		int axis_num = ip_list_.size();
+		std::vector <struct pollfd> fds(sockets_.size() + 1);
+		std::multimap <Clock::time_point,Pending> pending;
+		char buffer[2048];
+		Json::Reader reader;
+
+		for (size_t i=0; i<sockets_.size(); i++)
+		{
+			fds[i].fd = sockets_[i];
+			fds[i].events = POLLIN;
+		}
+		fds.back().fd = discovery_;
+		fds.back().events = POLLIN;
+
+		while (running_)
+		{
+			Clock::time_point now = Clock::now();
+
+			while (!pending.empty() && pending.begin()->first <= now)
+			{
+				Pending &p = pending.begin()->second;
+				sendto(p.socket,p.data.c_str(),p.data.size(),0,(struct sockaddr *)&p.to,sizeof(p.to));
+				pending.erase(pending.begin());
+			}
+
+			struct timespec timeout = {0,10000000};
+			if (!pending.empty())
+			{
+				long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(pending.begin()->first - now).count();
+				timeout.tv_sec = ns / 1000000000;
+				timeout.tv_nsec = ns % 1000000000;
+			}
+
+			if (ppoll(fds.data(),fds.size(),&timeout,NULL) <= 0)
+			{
+				continue;
+			}
+
+			now = Clock::now();
+
+			if (fds.back().revents & POLLIN)
+			{
+				AnswerDiscovery(discovery_,std::vector <int> (sockets_.begin(),sockets_.begin() + axis_num));
+			}
+
+			for (size_t k=0; k<sockets_.size(); k++)
+			{
+				if (!(fds[k].revents & POLLIN))
+				{
+					continue;
+				}
+
+				Pending p;
+				socklen_t from_len = sizeof(p.to);
+				ssize_t len = recvfrom(sockets_[k],buffer,sizeof(buffer),0,(struct sockaddr *)&p.to,&from_len);
+				if (len <= 0)
+				{
+					continue;
+				}
+
+				Json::Value request;
+				if (!reader.parse(buffer,buffer + strnlen(buffer,len),request) || !request.isObject() || !ReplyEnabled(request))
+				{
+					continue;
+				}
+
+				int axis = k % axis_num;
+				int port = (int)k < axis_num ? 2334 : 2333;
+				std::map <std::string,Sequence>::iterator it = sequences_[axis].find(Key(port,request));
+				if (it == sequences_[axis].end())
+				{
+					continue;
+				}
+
+				Sequence &s = it->second;
+				const Exchange &e = s.exchanges[s.cursor++ % s.exchanges.size()];
+				p.socket = sockets_[k];
+
+				for (size_t j=0; j<e.replies.size(); j++)
+				{
+					p.data = e.replies[j].second;
+					Clock::duration delay = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(e.replies[j].first));
+					pending.insert(std::make_pair(now + delay,p));
+				}
+			}
+		}
+	}
+
+public:
+	ReplayResponder():discovery_(-1),running_(false)
+	{
+	}
+
+	~ReplayResponder()
+	{
+		Stop();
+	}
+
+	/**
+	 * @brief 读取录制文件
+	 * @param[in] file_path 录制文件路径
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int Load(const std::string file_path)
+	{
+		std::ifstream in(file_path.c_str());
+		std::string line;
+		Json::Reader reader;
+		std::vector <Json::Value> records;
+
+		if (!in.is_open())
+		{
+			return -1;
+		}
+
+		ip_list_.clear();
+		sequences_.clear();
+
+		/* 应答过的地址才是执行器，发往广播地址的发现请求不计入 */
+		while (std::getline(in,line))
+		{
+			Json::Value record;
+			if (!reader.parse(line,record) || !record.isObject())
+			{
+				continue;
+			}
+
+			std::string ip = record["ip"].asString();
+			if (record["dir"].asString() == "rx" && std::find(ip_list_.begin(),ip_list_.end(),ip) == ip_list_.end())
+			{
+				ip_list_.push_back(ip);
+			}
+			records.push_back(record);
+		}
+
+		sequences_.resize(ip_list_.size());
+		std::map <std::pair <size_t,int>,std::vector <Outstanding> > outstanding;
+
+		for (size_t i=0; i<records.size(); i++)
+		{
+			const Json::Value &record = records[i];
+			size_t axis = std::find(ip_list_.begin(),ip_list_.end(),record["ip"].asString()) - ip_list_.begin();
+			int port = record["port"].asInt();
+			Json::Value data;
+
+			if (axis == ip_list_.size() || !reader.parse(record["data"].asString(),data) || !data.isObject())
+			{
+				continue;
+			}
+
+			std::vector <Outstanding> &queue = outstanding[std::make_pair(axis,port)];
+
+			/* reply_enable为false的请求回放时不回复，不计入交互 */
+			if (record["dir"].asString() == "tx")
+			{
+				if (ReplyEnabled(data))
+				{
+					Exchange e;
+					e.t = record["t"].asDouble();
+
+					Outstanding o;
+					o.target = Target(data);
+					o.key = Key(port,data);
+					o.index = sequences_[axis][o.key].exchanges.size();
+					sequences_[axis][o.key].exchanges.push_back(e);
+					queue.push_back(o);
+				}
+				continue;
+			}
+
+			/* 没有reqTarget的应答匹配最早的请求，之前同一reqTarget未应答的请求视为丢失 */
+			std::string target = Target(data);
+			for (size_t j=0; j<queue.size(); j++)
+			{
+				if (target.empty() || queue[j].target == target)
+				{
+					Exchange &e = sequences_[axis][queue[j].key].exchanges[queue[j].index];
+					e.replies.push_back(std::make_pair(record["t"].asDouble() - e.t,record["data"].asString()));
+
+					std::string matched = queue[j].target;
+					for (size_t m=j+1; m-- > 0; )
+					{
+						if (m == j || queue[m].target == matched)
+						{
+							queue.erase(queue.begin() + m);
+						}
+					}
+					break;
+				}
+			}
+		}
+
+		return ip_list_.empty() ? -1 : 0;
+	}
+
+	/**
+	 * @brief 录制文件中的执行器个数
+	 */
+	int Size() const
+	{
+		return ip_list_.size();
+	}
+
+	/**
+	 * @brief 打开套接字并启动回放线程
+	 * @return 执行成功与否
+	 *	 @retval 0 成功 
+	 *	 @retval -1 失败
+	 */
+	int Start()
+	{
+		if (ip_list_.empty() || OpenLoopbackSockets(ip_list_.size(),2334,sockets_) == -1 ||
+			OpenLoopbackSockets(ip_list_.size(),2333,sockets_) == -1 || (discovery_ = OpenDiscoverySocket()) == -1)
+		{
+			Stop();
+			return -1;
+		}
+
+		running_ = true;
+		thread_ = std::thread(&ReplayResponder::Run,this);
+		return 0;
+	}
+
+	void Stop()
+	{
+		running_ = false;
+
+		if (thread_.joinable())
+		{
+			thread_.join();
+		}
+
+		for (size_t i=0; i<sockets_.size(); i++)
+		{
+			close(sockets_[i]);
+		}
+		sockets_.clear();
+
+		if (discovery_ >= 0)
+		{
+			close(discovery_);
+			discovery_ = -1;
+		}
+	}
+};
+
+#endif
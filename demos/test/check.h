@@ -0,0 +1,28 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <iostream>
+#include <string>
+
+/* 各测试共用的断言与结果输出 */
+static int g_failed = 0;
+
+static void Check(const bool ok,const std::string what)
+{
+	if (!ok)
+	{
+		std::cout << "FAIL: " << what << std::endl;
+		g_failed++;
+	}
+}
+
+static int Report()
+{
+	if (g_failed == 0)
+	{
+		std::cout << "OK" << std::endl;
+	}
+	return g_failed == 0 ? 0 : 1;
+}
+
+#endif
@@ -0,0 +1,84 @@
+#include <math.h>
+#include <iostream>
+
+#include "cvp_estimator.h"
+#include "check.h"
+
+using namespace std;
+
+static Amber::CvpData Sample(const double pos0,const double pos1,const double vel0,const double vel1)
+{
+	Amber::CvpData fb;
+	fb.pos.resize(2);
+	fb.vel.resize(2);
+	fb.current = Eigen::VectorXd::Constant(2,0.5);
+	fb.pos << pos0,pos1;
+	fb.vel << vel0,vel1;
+	return fb;
+}
+
+int main()
+{
+	Amber::CvpEstimator estimator(2,0.5,0.1,0.02);
+	Amber::CvpData state;
+	vector <bool> stale;
+
+	/* 尚无样本时全部轴过期 */
+	Check(estimator.GetState(1.0,state,stale) == -1 && stale[0] && stale[1],"no sample is stale");
+
+	/* 匀速运动：样本间的预测应落在真实轨迹上 */
+	const double v = 1000.0;
+	double t = 1.0;
+	for (int k=0; k<10; k++,t+=0.004)
+	{
+		Check(estimator.Update(Sample(v * t,-v * t,v,-v),t) == 0,"update");
+	}
+	t -= 0.004;
+
+	for (double dt=0.0005; dt<0.004; dt+=0.0005)
+	{
+		Check(estimator.GetState(t + dt,state,stale) == 0 && !stale[0] && !stale[1],"fresh between samples");
+		Check(fabs(state.pos(0) - v * (t + dt)) < 1e-6,"axis 0 predicted between samples");
+		Check(fabs(state.pos(1) + v * (t + dt)) < 1e-6,"axis 1 predicted between samples");
+		Check(fabs(state.vel(0) - v) < 1e-6 && fabs(state.current(0) - 0.5) < 1e-12,"velocity and current");
+	}
+
+	/* 位置残差按alpha修正位置，按beta/间隔修正速度 */
+	Amber::CvpEstimator step(1,0.5,0.1,0.02);
+	Amber::CvpData fb;
+	fb.pos = Eigen::VectorXd::Constant(1,0.0);
+	fb.vel = Eigen::VectorXd::Zero(1);
+	fb.current = Eigen::VectorXd::Zero(1);
+	step.Update(fb,0.0);
+	fb.pos(0) = 10.0;
+	step.Update(fb,0.01);
+	step.GetState(0.01,state,stale);
+	Check(fabs(state.pos(0) - 5.0) < 1e-9 && fabs(state.vel(0) - 100.0) < 1e-9,"alpha-beta correction");
+	step.GetState(0.015,state,stale);
+	Check(fabs(state.pos(0) - 5.5) < 1e-9,"extrapolation after correction");
+
+	/* 早于已有样本的时间戳被忽略 */
+	fb.pos(0) = 1000.0;
+	step.Update(fb,0.005);
+	step.GetState(0.01,state,stale);
+	Check(fabs(state.pos(0) - 5.0) < 1e-9,"older sample ignored");
+
+	/* 超过stale_time未更新的轴过期，只更新部分轴时其余轴过期 */
+	Check(estimator.GetState(t + 0.03,state,stale) == -1 && stale[0] && stale[1],"all axes stale");
+
+	Amber::CvpData part;
+	part.pos = Eigen::VectorXd::Constant(1,v * (t + 0.03));
+	part.vel = Eigen::VectorXd::Constant(1,v);
+	part.current = Eigen::VectorXd::Zero(1);
+	Check(estimator.Update(vector <int> {0},part,t + 0.03) == 0,"index update");
+	Check(estimator.GetState(t + 0.031,state,stale) == -1 && !stale[0] && stale[1],"only axis 1 stale");
+	Check(fabs(state.pos(0) - v * (t + 0.031)) < 1e-6,"index update prediction");
+
+	Check(estimator.Update(vector <int> {2},part,t + 0.04) == -1,"index out of range rejected");
+	Check(estimator.Update(Sample(0,0,0,0),t + 0.04) == 0 && estimator.Update(part,t + 0.05) == -1,"size mismatch rejected");
+
+	estimator.Reset();
+	Check(estimator.GetState(t,state,stale) == -1 && stale[0] && stale[1],"reset clears samples");
+
+	return Report();
+}
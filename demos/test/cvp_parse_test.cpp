@@ -0,0 +1,64 @@
+#include <locale.h>
+#include <iostream>
+
+#include "cvp_parser.h"
+#include "check.h"
+
+using namespace std;
+
+static int Parse(const string reply,Amber::CvpData &fb)
+{
+	fb.pos = Eigen::VectorXd::Constant(2,-1.0);
+	fb.vel = Eigen::VectorXd::Constant(2,-1.0);
+	fb.current = Eigen::VectorXd::Constant(2,-1.0);
+	return Amber::ParseCvpReply(reply.data(),reply.size(),fb,1);
+}
+
+int main()
+{
+	Amber::CvpData fb;
+
+	/* 与Json::Reader的结果一致 */
+	const string reply = "{\"current\":0.123,\"position\":12345.678,\"reqTarget\":\"/m1/CVP\",\"status\":\"OK\",\"velocity\":-3.25}\n";
+	Json::Value root;
+	Json::Reader().parse(reply,root);
+	Check(Parse(reply,fb) == 0,"reply with reqTarget accepted");
+	Check(fb.pos(1) == root["position"].asDouble() && fb.vel(1) == root["velocity"].asDouble() && fb.current(1) == root["current"].asDouble(),
+		"values match Json::Reader");
+	Check(fb.pos(0) == -1.0,"other elements untouched");
+
+	Check(Parse(" { \"position\" : 1e3 , \"velocity\":-2.5E-1,\"current\":0 , \"method\":\"GET\",\"reply_enable\":true,\"x\":null}",fb) == 0 &&
+		fb.pos(1) == 1000.0 && fb.vel(1) == -0.25 && fb.current(1) == 0.0,"whitespace, exponents and skipped keys");
+	Check(Parse(string("{\"position\":1,\"velocity\":2,\"current\":3}\n\0\0\0",43),fb) == 0,"NUL padding");
+	Check(Parse("{\"reqTarget\":\"/m1/\\\"CVP\\\"\",\"position\":1,\"velocity\":2,\"current\":3}",fb) == 0,"escaped quotes skipped");
+
+	/* 小数点为','的locale下结果不变，系统未安装该locale时跳过 */
+	if (setlocale(LC_NUMERIC,"de_DE.UTF-8") != NULL)
+	{
+		Check(Parse("{\"position\":1.5,\"velocity\":-0.25,\"current\":2e-3}",fb) == 0 && fb.pos(1) == 1.5 && fb.vel(1) == -0.25 && fb.current(1) == 0.002,
+			"locale independent");
+		setlocale(LC_NUMERIC,"C");
+	}
+
+	/* 以下均退回通用解析，且不修改fb */
+	const char *rejected[] = {
+		"{\"position\":1,\"velocity\":2,\"current\":3,\"status\":\"ERROR\"}",
+		"{\"position\":1,\"velocity\":2,\"current\":3,\"error\":0}",
+		"{\"position\":1,\"velocity\":2,\"current\":3,\"axis_error\":\"none\"}",
+		"{\"position\":1,\"velocity\":2}",
+		"{\"position\":\"1\",\"velocity\":2,\"current\":3}",
+		"{\"position\":1,\"velocity\":2,\"current\":3,\"config\":{\"a\":1}}",
+		"{\"position\":1,\"velocity\":2,\"current\":3,\"list\":[1]}",
+		"{\"position\":1,\"velocity\":2,\"current\":3,}",
+		"{\"position\":1,\"velocity\":2,\"current\":3",
+		"{\"position\":1-,\"velocity\":2,\"current\":3}",
+		"{\"position\":1.00000000000000000000000000000000,\"velocity\":2,\"current\":3}",
+		"",
+	};
+	for (size_t i=0; i<sizeof(rejected)/sizeof(rejected[0]); i++)
+	{
+		Check(Parse(rejected[i],fb) == -1 && fb.pos(1) == -1.0 && fb.vel(1) == -1.0 && fb.current(1) == -1.0,string("rejected: ") + rejected[i]);
+	}
+
+	return Report();
+}
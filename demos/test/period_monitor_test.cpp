@@ -0,0 +1,51 @@
+#include <iostream>
+
+#include "period_calibration.h"
+#include "check.h"
+
+using namespace std;
+
+int main()
+{
+	/* 预算为窗口内1次超时 */
+	Amber::PeriodMonitor monitor(1000,0.01,100,1600);
+
+	for (int k=0; k<100; k++)
+	{
+		Check(monitor.Update(false) == 1000,"no miss keeps base period");
+	}
+
+	/* 窗口内第二次超时超过预算，周期增大25% */
+	Check(monitor.Update(true) == 1000,"miss within budget");
+	Check(monitor.Update(true) == 1250,"miss over budget backs off");
+	Check(monitor.Update(true) == 1250 && monitor.Update(true) == 1562,"repeated congestion backs off further");
+	Check(monitor.Update(true) == 1562 && monitor.Update(true) == 1600,"period limited to max_period");
+
+	/* 无超时的窗口逐步回到基准周期 */
+	int period = monitor.GetPeriod();
+	int windows = 0;
+	while (period > monitor.GetBase() && windows < 100)
+	{
+		for (int k=0; k<100; k++)
+		{
+			period = monitor.Update(false);
+		}
+		windows++;
+	}
+	Check(period == 1000 && windows == 5,"recovers to base period");
+	Check(monitor.Update(false) == 1000,"never below base period");
+
+	/* 窗口内超时数在预算一半以上时保持周期 */
+	Amber::PeriodMonitor hold(1000,0.02,100,0);
+	hold.Update(true);
+	hold.Update(true);
+	hold.Update(true);
+	Check(hold.GetPeriod() == 1250,"default max_period allows back-off");
+	for (int k=0; k<100; k++)
+	{
+		hold.Update(k < 2);
+	}
+	Check(hold.GetPeriod() == 1250,"window near budget holds period");
+
+	return Report();
+}